@@ -90,13 +90,13 @@ void map_info(unsigned y, unsigned x, grid_data *g)
 	g->unseen_money = FALSE;
 
 	/* Use real feature (remove later) */
-	g->f_idx = cave->squares[y][x].feat;
+	g->f_idx = sq_feat(cave, y, x);
 	if (f_info[g->f_idx].mimic)
 		g->f_idx = f_info[g->f_idx].mimic;
 
 	g->in_view = (square_isseen(cave, y, x)) ? TRUE : FALSE;
-	g->is_player = (cave->squares[y][x].mon < 0) ? TRUE : FALSE;
-	g->m_idx = (g->is_player) ? 0 : cave->squares[y][x].mon;
+	g->is_player = (sq_mon(cave, y, x) < 0) ? TRUE : FALSE;
+	g->m_idx = (g->is_player) ? 0 : sq_mon(cave, y, x);
 	g->hallucinate = player->timed[TMD_IMAGE] ? TRUE : FALSE;
 	g->trapborder = (square_isdedge(cave, y, x)) ? TRUE : FALSE;
 
@@ -107,22 +107,23 @@ void map_info(unsigned y, unsigned x, grid_data *g)
 			g->lighting = LIGHTING_TORCH;
 
 		/* Remember seen feature */
-		cave_k->squares[y][x].feat = cave->squares[y][x].feat;
+		sq_feat(cave_k, y, x) = sq_feat(cave, y, x);
+		square_update_planes(cave_k, y, x);
 	} else if (!square_ismark(cave, y, x)) {
 		g->f_idx = FEAT_NONE;
-		//cave_k->squares[y][x].feat = FEAT_NONE;
+		//sq_feat(cave_k, y, x) = FEAT_NONE;
 	} else if (square_isglow(cave, y, x)) {
 		g->lighting = LIGHTING_LIT;
 	}
 
 	/* Use known feature */
-/*	g->f_idx = cave_k->squares[y][x].feat;
+/*	g->f_idx = sq_feat(cave_k, y, x);
 	if (f_info[g->f_idx].mimic)
 		g->f_idx = f_info[g->f_idx].mimic;*/
 
     /* There is a trap in this square */
     if (square_istrap(cave, y, x) && square_ismark(cave, y, x)) {
-		struct trap *trap = cave->squares[y][x].trap;
+		struct trap *trap = sq_trap(cave, y, x);
 
 		/* Scan the square trap list */
 		while (trap) {
@@ -226,7 +227,7 @@ void square_note_spot(struct chunk *c, int y, int x)
 		return;
 
 	/* Memorize this grid */
-	sqinfo_on(c->squares[y][x].info, SQUARE_MARK);
+	sqinfo_on(sq_info(c, y, x), SQUARE_MARK);
 }
 
 
@@ -234,17 +235,51 @@ void square_note_spot(struct chunk *c, int y, int x)
 /**
  * Tell the UI that a given map location has been updated
  *
+ * The grid is only marked here; the UI hears about all the marked grids at
+ * once from cave_flush_redraw(), which redraw_stuff() calls.
+ *
  * This function should only be called on "legal" grids.
  */
 void square_light_spot(struct chunk *c, int y, int x)
 {
 	if (c == cave) {
 		player->upkeep->redraw |= PR_ITEMLIST;
-		event_signal_point(EVENT_MAP, x, y);
+		c->redraw[y * c->plane_stride + (x >> 5)] |= sq_plane_bit(x);
+
+		if (y < c->redraw_min.y) c->redraw_min.y = y;
+		if (y > c->redraw_max.y) c->redraw_max.y = y;
+		if (x < c->redraw_min.x) c->redraw_min.x = x;
+		if (x > c->redraw_max.x) c->redraw_max.x = x;
 	}
 }
 
 
+/**
+ * Send the grids marked by square_light_spot() to the UI as one map region,
+ * then clear them.
+ */
+void cave_flush_redraw(struct chunk *c)
+{
+	struct loc min = c->redraw_min;
+	struct loc max = c->redraw_max;
+	int y;
+
+	/* Nothing marked */
+	if (max.y < min.y)
+		return;
+
+	/* Reset the box first, in case a handler marks more grids */
+	c->redraw_min = loc(c->width, c->height);
+	c->redraw_max = loc(-1, -1);
+
+	event_signal_region(EVENT_MAP, min, max, c->redraw, c->plane_stride);
+
+	for (y = min.y; y <= max.y; y++)
+		memset(&c->redraw[y * c->plane_stride + (min.x >> 5)], 0,
+			   ((max.x >> 5) - (min.x >> 5) + 1) * sizeof(u32b));
+}
+
+
 /**
  * This routine will Perma-Light all grids in the set passed in.
  *
@@ -269,7 +304,7 @@ static void cave_light(struct point_set *ps)
 		int x = ps->pts[i].x;
 
 		/* Perma-Light */
-		sqinfo_on(cave->squares[y][x].info, SQUARE_GLOW);
+		sqinfo_on(sq_info(cave, y, x), SQUARE_GLOW);
 	}
 
 	/* Fully update the visuals */
@@ -288,7 +323,7 @@ static void cave_light(struct point_set *ps)
 		square_light_spot(cave, y, x);
 
 		/* Process affected monsters */
-		if (cave->squares[y][x].mon > 0)
+		if (sq_mon(cave, y, x) > 0)
 		{
 			int chance = 25;
 
@@ -332,11 +367,11 @@ static void cave_unlight(struct point_set *ps)
 		int x = ps->pts[i].x;
 
 		/* Darken the grid */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_GLOW);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_GLOW);
 
 		/* Hack -- Forget "boring" grids */
 		if (square_isfloor(cave, y, x))
-			sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 	}
 
 	/* Fully update the visuals */
@@ -442,13 +477,14 @@ void wiz_light(struct chunk *c, bool full)
 					int xx = x + ddx_ddd[i];
 
 					/* Perma-light the grid */
-					sqinfo_on(c->squares[yy][xx].info, SQUARE_GLOW);
+					sqinfo_on(sq_info(c, yy, xx), SQUARE_GLOW);
 
 					/* Memorize normal features */
 					if (!square_isfloor(c, yy, xx) || 
 						square_isvisibletrap(c, yy, xx)) {
-						sqinfo_on(c->squares[yy][xx].info, SQUARE_MARK);
-						cave_k->squares[yy][xx].feat = c->squares[yy][xx].feat;
+						sqinfo_on(sq_info(c, yy, xx), SQUARE_MARK);
+						sq_feat(cave_k, yy, xx) = sq_feat(c, yy, xx);
+						square_update_planes(cave_k, yy, xx);
 					}
 				}
 			}
@@ -487,9 +523,9 @@ void wiz_dark(void)
 			struct object *obj;
 
 			/* Process the grid */
-			sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
-			sqinfo_off(cave->squares[y][x].info, SQUARE_DTRAP);
-			sqinfo_off(cave->squares[y][x].info, SQUARE_DEDGE);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_DTRAP);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_DEDGE);
 
 			/* Forget all objects */
 			for (obj = square_object(cave, y, x); obj; obj = obj->next) {
@@ -523,7 +559,7 @@ void cave_illuminate(struct chunk *c, bool daytime)
 		for (x = 0; x < c->width; x++) {
 			int d;
 			bool light = FALSE;
-			feature_type *f_ptr = &f_info[c->squares[y][x].feat];
+			feature_type *f_ptr = &f_info[sq_feat(c, y, x)];
 			
 			/* Skip grids with no surrounding floors or stairs */
 			for (d = 0; d < 9; d++) {
@@ -543,11 +579,11 @@ void cave_illuminate(struct chunk *c, bool daytime)
 
 			/* Only interesting grids at night */
 			if (daytime || !tf_has(f_ptr->flags, TF_FLOOR)) {
-				sqinfo_on(c->squares[y][x].info, SQUARE_GLOW);
-				sqinfo_on(c->squares[y][x].info, SQUARE_MARK);
+				sqinfo_on(sq_info(c, y, x), SQUARE_GLOW);
+				sqinfo_on(sq_info(c, y, x), SQUARE_MARK);
 			} else {
-				sqinfo_off(c->squares[y][x].info, SQUARE_GLOW);
-				sqinfo_off(c->squares[y][x].info, SQUARE_MARK);
+				sqinfo_off(sq_info(c, y, x), SQUARE_GLOW);
+				sqinfo_off(sq_info(c, y, x), SQUARE_MARK);
 			}
 		}
 			
@@ -560,8 +596,8 @@ void cave_illuminate(struct chunk *c, bool daytime)
 			for (i = 0; i < 8; i++) {
 				int yy = y + ddy_ddd[i];
 				int xx = x + ddx_ddd[i];
-				sqinfo_on(c->squares[yy][xx].info, SQUARE_GLOW);
-				sqinfo_on(c->squares[yy][xx].info, SQUARE_MARK);
+				sqinfo_on(sq_info(c, yy, xx), SQUARE_GLOW);
+				sqinfo_on(sq_info(c, yy, xx), SQUARE_MARK);
 			}
 		}
 	}
@@ -574,11 +610,6 @@ void cave_illuminate(struct chunk *c, bool daytime)
 	player->upkeep->redraw |= (PR_MAP | PR_MONLIST | PR_ITEMLIST);
 }
 
-/**
- * Size of the circular queue used by "update_flow()"
- */
-#define FLOW_MAX 2048
-
 /*
  * Hack -- provide some "speed" for the "flow" code
  * This entry is the "current index" for the "when" field
@@ -602,25 +633,29 @@ static int flow_save = 0;
  */
 void cave_forget_flow(struct chunk *c)
 {
-	int x, y;
-
 	/* Nothing to forget */
 	if (!flow_save) return;
 
-	/* Check the entire dungeon */
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
-			/* Forget the old data */
-			c->squares[y][x].cost = 0;
-			c->squares[y][x].when = 0;
-		}
-	}
+	/* Forget the old data for the entire dungeon */
+	memset(c->cost, 0, c->height * c->width * sizeof(byte));
+	memset(c->when, 0, c->height * c->width * sizeof(byte));
 
 	/* Start over */
 	flow_save = 0;
 }
 
 
+/**
+ * Get the chunk's queue for building flows, with room for every grid.
+ */
+static int *flow_queue_get(struct chunk *c)
+{
+	if (!c->flow_queue)
+		c->flow_queue = mem_alloc(c->height * c->width * sizeof(int));
+	return c->flow_queue;
+}
+
+
 /*
  * Hack -- fill in the "cost" field of every grid that the player can
  * "reach" with the number of steps needed to reach that grid.  This
@@ -629,8 +664,8 @@ void cave_forget_flow(struct chunk *c)
  * In addition, mark the "when" of the grids that can reach the player
  * with the incremented value of "flow_save".
  *
- * Hack -- use the local "flow_y" and "flow_x" arrays as a "circular
- * queue" of cave grids.
+ * Each grid is stamped when it is queued, so it is queued at most once, and
+ * a queue as big as the level can never overflow.
  *
  * We do not need a priority queue because the cost from grid to grid
  * is always "one" (even along diagonals) and we process them in order.
@@ -651,8 +686,7 @@ void cave_update_flow(struct chunk *c)
 	int flow_tail = 0;
 	int flow_head = 0;
 
-	byte flow_y[FLOW_MAX];
-	byte flow_x[FLOW_MAX];
+	int *flow_queue = flow_queue_get(c);
 
 
 	/*** Cycle the flow ***/
@@ -661,13 +695,10 @@ void cave_update_flow(struct chunk *c)
 	if (flow_save++ == 255)
 	{
 		/* Cycle the flow */
-		for (y = 0; y < c->height; y++)
+		for (n = 0; n < c->height * c->width; n++)
 		{
-			for (x = 0; x < c->width; x++)
-			{
-				int w = c->squares[y][x].when;
-				c->squares[y][x].when = (w >= 128) ? (w - 128) : 0;
-			}
+			int w = c->when[n];
+			c->when[n] = (w >= 128) ? (w - 128) : 0;
 		}
 
 		/* Restart */
@@ -681,17 +712,13 @@ void cave_update_flow(struct chunk *c)
 	/*** Player Grid ***/
 
 	/* Save the time-stamp */
-	c->squares[py][px].when = flow_n;
+	sq_when(c, py, px) = flow_n;
 
 	/* Save the flow cost */
-	c->squares[py][px].cost = 0;
+	sq_cost(c, py, px) = 0;
 
 	/* Enqueue that entry */
-	flow_y[flow_head] = py;
-	flow_x[flow_head] = px;
-
-	/* Advance the queue */
-	++flow_tail;
+	flow_queue[flow_tail++] = square_idx(c, py, px);
 
 
 	/*** Process Queue ***/
@@ -700,14 +727,12 @@ void cave_update_flow(struct chunk *c)
 	while (flow_head != flow_tail)
 	{
 		/* Extract the next entry */
-		ty = flow_y[flow_head];
-		tx = flow_x[flow_head];
-
-		/* Forget that entry (with wrap) */
-		if (++flow_head == FLOW_MAX) flow_head = 0;
+		ty = flow_queue[flow_head] / c->width;
+		tx = flow_queue[flow_head] % c->width;
+		flow_head++;
 
 		/* Child cost */
-		n = c->squares[ty][tx].cost + 1;
+		n = sq_cost(c, ty, tx) + 1;
 
 		/* Hack -- Limit flow depth */
 		if (n == z_info->max_flow_depth) continue;
@@ -715,44 +740,245 @@ void cave_update_flow(struct chunk *c)
 		/* Add the "children" */
 		for (d = 0; d < 8; d++)
 		{
-			int old_head = flow_tail;
-
 			/* Child location */
 			y = ty + ddy_ddd[d];
 			x = tx + ddx_ddd[d];
 			if (!square_in_bounds(c, y, x)) continue;
 
 			/* Ignore "pre-stamped" entries */
-			if (c->squares[y][x].when == flow_n) continue;
+			if (sq_when(c, y, x) == flow_n) continue;
 
 			/* Ignore "walls" and "rubble" */
-			if (tf_has(f_info[c->squares[y][x].feat].flags, TF_NO_FLOW))
+			if (sq_plane_has(c, SQUARE_PLANE_NO_FLOW, y, x))
 				continue;
 
 			/* Save the time-stamp */
-			c->squares[y][x].when = flow_n;
+			sq_when(c, y, x) = flow_n;
 
 			/* Save the flow cost */
-			c->squares[y][x].cost = n;
+			sq_cost(c, y, x) = n;
+
+			/* Wake parked monsters the noise now reaches */
+			if (sq_mon(c, y, x) > 0) {
+				int m_idx = sq_mon(c, y, x);
+				if (c->dormant_slot[m_idx] &&
+					n < cave_monster(c, m_idx)->race->aaf)
+					cave_monster_unpark(c, m_idx);
+			}
 
 			/* Enqueue that entry */
-			flow_y[flow_tail] = y;
-			flow_x[flow_tail] = x;
+			flow_queue[flow_tail++] = square_idx(c, y, x);
+		}
+	}
+}
+
+
+/**
+ * Can a flow field of the given type pass through a grid?
+ */
+static bool flow_passes(struct chunk *c, enum flow_type type, int y, int x)
+{
+	if (type == FLOW_PASSWALL)
+		return !square_isperm(c, y, x);
+
+	/* Doors and floors, as for the scent flow */
+	return !sq_plane_has(c, SQUARE_PLANE_NO_FLOW, y, x);
+}
+
+/**
+ * Fill in a distance field from the player by breadth first search over
+ * the grids the field type can pass through.
+ */
+static void flow_fill_distance(struct chunk *c, enum flow_type type,
+							   s16b *dist, int *queue)
+{
+	int head = 0, tail = 0;
+	int n, d;
 
-			/* Advance the queue */
-			if (++flow_tail == FLOW_MAX) flow_tail = 0;
+	for (n = 0; n < c->height * c->width; n++)
+		dist[n] = FLOW_UNREACHED;
 
-			/* Hack -- Overflow by forgetting new entry */
-			if (flow_tail == flow_head) flow_tail = old_head;
+	dist[square_idx(c, player->py, player->px)] = 0;
+	queue[tail++] = square_idx(c, player->py, player->px);
+
+	while (head != tail) {
+		int ty = queue[head] / c->width;
+		int tx = queue[head] % c->width;
+		int cost = dist[queue[head++]] + 1;
+
+		for (d = 0; d < 8; d++) {
+			int y = ty + ddy_ddd[d];
+			int x = tx + ddx_ddd[d];
+
+			if (!square_in_bounds(c, y, x)) continue;
+			if (dist[square_idx(c, y, x)] != FLOW_UNREACHED) continue;
+			if (!flow_passes(c, type, y, x)) continue;
+
+			dist[square_idx(c, y, x)] = cost;
+			queue[tail++] = square_idx(c, y, x);
+		}
+	}
+}
+
+/**
+ * Fill in the flee field.
+ *
+ * Every grid reachable through doors is seeded with -6/5 of its distance
+ * from the player, and then the seeds are relaxed outwards with a step cost
+ * of one (a multi-source Dijkstra search), so that walking downhill leads
+ * away from the player without running into dead ends near the player.
+ *
+ * Because every step costs one, the search needs no heap: the seeds are
+ * counting sorted by value, and relaxed grids are queued in a FIFO whose
+ * values never decrease, so the next grid is always at the front of one of
+ * the two queues.
+ */
+static void flow_fill_flee(struct chunk *c, s16b *flee, int *queue)
+{
+	s16b *dist = cave_flow(c, FLOW_DOORS);
+	int size = c->height * c->width;
+	int max = 0, num = 0, seeds_head = 0, head = 0, tail = 0;
+	int *seeds, *count;
+	bool *done;
+	int n, d, v;
+
+	/* A grid is at most size steps away, so a value is at most 6/5 of that */
+	if (!c->flow_seeds) {
+		c->flow_seeds = mem_alloc(size * sizeof(int));
+		c->flow_count = mem_alloc((size * 6 / 5 + 2) * sizeof(int));
+		c->flow_done = mem_alloc(size * sizeof(bool));
+	}
+	seeds = c->flow_seeds;
+	count = c->flow_count;
+	done = c->flow_done;
+	memset(done, 0, size * sizeof(bool));
+
+	/* Seed the reachable grids */
+	for (n = 0; n < size; n++) {
+		if (dist[n] == FLOW_UNREACHED) {
+			flee[n] = FLOW_UNREACHED;
+			continue;
+		}
+		flee[n] = -(dist[n] * 6 / 5);
+		max = MAX(max, -flee[n]);
+		num++;
+	}
+
+	/* Counting sort the seeds, lowest (furthest) first */
+	memset(count, 0, (max + 2) * sizeof(int));
+	for (n = 0; n < size; n++)
+		if (flee[n] != FLOW_UNREACHED)
+			count[max + flee[n] + 1]++;
+	for (v = 1; v <= max + 1; v++)
+		count[v] += count[v - 1];
+	for (n = 0; n < size; n++)
+		if (flee[n] != FLOW_UNREACHED)
+			seeds[count[max + flee[n]]++] = n;
+
+	/* Relax in order of value */
+	while (seeds_head < num || head < tail) {
+		int cur, ty, tx;
+
+		/* Take the lower of the two queue fronts */
+		if (head == tail ||
+			(seeds_head < num &&
+			 flee[seeds[seeds_head]] <= flee[queue[head]]))
+			cur = seeds[seeds_head++];
+		else
+			cur = queue[head++];
+
+		/* Each grid is final the first time it comes out */
+		if (done[cur]) continue;
+		done[cur] = TRUE;
+
+		ty = cur / c->width;
+		tx = cur % c->width;
+		for (d = 0; d < 8; d++) {
+			int y = ty + ddy_ddd[d];
+			int x = tx + ddx_ddd[d];
+			int next;
+
+			if (!square_in_bounds(c, y, x)) continue;
+			next = square_idx(c, y, x);
+			if (done[next] || flee[next] == FLOW_UNREACHED) continue;
+			if (flee[next] <= flee[cur] + 1) continue;
+
+			flee[next] = flee[cur] + 1;
+			queue[tail++] = next;
 		}
 	}
 }
 
+/**
+ * Get a flow field for the current player position.
+ *
+ * Fields are built on first use, and kept until the player moves or any
+ * terrain in the chunk changes.  The result is indexed by square_idx(), and
+ * holds FLOW_UNREACHED for grids the field cannot reach.
+ */
+s16b *cave_flow(struct chunk *c, enum flow_type type)
+{
+	struct flow *flow = &c->flows[type];
+	int *queue;
+
+	/* Still good */
+	if (flow->dist && flow->stamp == c->terrain_stamp &&
+		flow->y == player->py && flow->x == player->px)
+		return flow->dist;
+
+	if (!flow->dist)
+		flow->dist = mem_alloc(c->height * c->width * sizeof(s16b));
+
+	/* Build it */
+	queue = flow_queue_get(c);
+	if (type == FLOW_FLEE)
+		flow_fill_flee(c, flow->dist, queue);
+	else
+		flow_fill_distance(c, type, flow->dist, queue);
+
+	flow->stamp = c->terrain_stamp;
+	flow->y = player->py;
+	flow->x = player->px;
+
+	return flow->dist;
+}
+
+/**
+ * Find the adjacent grid which is lowest on a flow field, if it is lower than
+ * the given grid.
+ */
+bool cave_flow_downhill(struct chunk *c, enum flow_type type, int y, int x,
+						int *ny, int *nx)
+{
+	s16b *field = cave_flow(c, type);
+	int best = field[square_idx(c, y, x)];
+	bool found = FALSE;
+	int i;
+
+	/* Check nearby grids, diagonals first */
+	for (i = 7; i >= 0; i--) {
+		int yy = y + ddy_ddd[i];
+		int xx = x + ddx_ddd[i];
+
+		if (!square_in_bounds(c, yy, xx)) continue;
+		if (field[square_idx(c, yy, xx)] >= best) continue;
+
+		best = field[square_idx(c, yy, xx)];
+		*ny = yy;
+		*nx = xx;
+		found = TRUE;
+	}
+
+	return found;
+}
+
 /* Make map features known */
 void cave_known (void)
 {
-	int y,x;
-	for (y = 0; y < cave->height; y++)
-		for (x = 0; x < cave->width; x++)
-			cave_k->squares[y][x].feat = cave->squares[y][x].feat;
+	int i;
+
+	memcpy(cave_k->feat, cave->feat, cave->height * cave->width * sizeof(byte));
+	for (i = 0; i < SQUARE_PLANE_MAX; i++)
+		memcpy(cave_k->plane[i], cave->plane[i],
+			   cave->height * cave->plane_stride * sizeof(u32b));
 }
@@ -111,7 +111,7 @@ bool feat_is_bright(int feat)
  * SQUARE FEATURE PREDICATES
  *
  * These functions are used to figure out what kind of square something is,
- * via c->squares[y][x].feat. All direct testing of c->squares[y][x].feat should be rewritten
+ * via sq_feat(c, y, x). All direct testing of sq_feat(c, y, x) should be rewritten
  * in terms of these functions.
  *
  * It's often better to use square behavior predicates (written in terms of
@@ -127,7 +127,7 @@ bool feat_is_bright(int feat)
  */
 bool square_isfloor(struct chunk *c, int y, int x)
 {
-	return tf_has(f_info[c->squares[y][x].feat].flags, TF_FLOOR);
+	return tf_has(f_info[sq_feat(c, y, x)].flags, TF_FLOOR);
 }
 
 /**
@@ -135,8 +135,8 @@ bool square_isfloor(struct chunk *c, int y, int x)
  */
 bool square_isrock(struct chunk *c, int y, int x)
 {
-	return (tf_has(f_info[c->squares[y][x].feat].flags, TF_GRANITE) &&
-			!tf_has(f_info[c->squares[y][x].feat].flags, TF_DOOR_ANY));
+	return (tf_has(f_info[sq_feat(c, y, x)].flags, TF_GRANITE) &&
+			!tf_has(f_info[sq_feat(c, y, x)].flags, TF_DOOR_ANY));
 }
 
 /**
@@ -144,8 +144,8 @@ bool square_isrock(struct chunk *c, int y, int x)
  */
 bool square_isperm(struct chunk *c, int y, int x)
 {
-	return (tf_has(f_info[c->squares[y][x].feat].flags, TF_PERMANENT) &&
-			tf_has(f_info[c->squares[y][x].feat].flags, TF_ROCK));
+	return (tf_has(f_info[sq_feat(c, y, x)].flags, TF_PERMANENT) &&
+			tf_has(f_info[sq_feat(c, y, x)].flags, TF_ROCK));
 }
 
 /**
@@ -153,7 +153,7 @@ bool square_isperm(struct chunk *c, int y, int x)
  */
 bool square_ismagma(struct chunk *c, int y, int x)
 {
-	return feat_is_magma(c->squares[y][x].feat);
+	return feat_is_magma(sq_feat(c, y, x));
 }
 
 /**
@@ -161,7 +161,7 @@ bool square_ismagma(struct chunk *c, int y, int x)
  */
 bool square_isquartz(struct chunk *c, int y, int x)
 {
-	return feat_is_quartz(c->squares[y][x].feat);
+	return feat_is_quartz(sq_feat(c, y, x));
 }
 
 /**
@@ -175,7 +175,7 @@ bool square_ismineral(struct chunk *c, int y, int x)
 
 bool square_hasgoldvein(struct chunk *c, int y, int x)
 {
-	return tf_has(f_info[c->squares[y][x].feat].flags, TF_GOLD);
+	return tf_has(f_info[sq_feat(c, y, x)].flags, TF_GOLD);
 }
 
 /**
@@ -183,8 +183,8 @@ bool square_hasgoldvein(struct chunk *c, int y, int x)
  */
 bool square_isrubble(struct chunk *c, int y, int x)
 {
-    return (!tf_has(f_info[c->squares[y][x].feat].flags, TF_WALL) &&
-			tf_has(f_info[c->squares[y][x].feat].flags, TF_ROCK));
+    return (!tf_has(f_info[sq_feat(c, y, x)].flags, TF_WALL) &&
+			tf_has(f_info[sq_feat(c, y, x)].flags, TF_ROCK));
 }
 
 /**
@@ -195,8 +195,8 @@ bool square_isrubble(struct chunk *c, int y, int x)
  */
 bool square_issecretdoor(struct chunk *c, int y, int x)
 {
-    return (tf_has(f_info[c->squares[y][x].feat].flags, TF_DOOR_ANY) &&
-			tf_has(f_info[c->squares[y][x].feat].flags, TF_ROCK));
+    return (tf_has(f_info[sq_feat(c, y, x)].flags, TF_DOOR_ANY) &&
+			tf_has(f_info[sq_feat(c, y, x)].flags, TF_ROCK));
 }
 
 /**
@@ -204,7 +204,7 @@ bool square_issecretdoor(struct chunk *c, int y, int x)
  */
 bool square_isopendoor(struct chunk *c, int y, int x)
 {
-    return (tf_has(f_info[c->squares[y][x].feat].flags, TF_CLOSABLE));
+    return (tf_has(f_info[sq_feat(c, y, x)].flags, TF_CLOSABLE));
 }
 
 /**
@@ -212,13 +212,13 @@ bool square_isopendoor(struct chunk *c, int y, int x)
  */
 bool square_iscloseddoor(struct chunk *c, int y, int x)
 {
-	int feat = c->squares[y][x].feat;
+	int feat = sq_feat(c, y, x);
 	return tf_has(f_info[feat].flags, TF_DOOR_CLOSED);
 }
 
 bool square_isbrokendoor(struct chunk *c, int y, int x)
 {
-	int feat = c->squares[y][x].feat;
+	int feat = sq_feat(c, y, x);
     return (tf_has(f_info[feat].flags, TF_DOOR_ANY) &&
 			tf_has(f_info[feat].flags, TF_PASSABLE) &&
 			!tf_has(f_info[feat].flags, TF_CLOSABLE));
@@ -231,7 +231,7 @@ bool square_isbrokendoor(struct chunk *c, int y, int x)
  */
 bool square_isdoor(struct chunk *c, int y, int x)
 {
-	int feat = c->squares[y][x].feat;
+	int feat = sq_feat(c, y, x);
 	return tf_has(f_info[feat].flags, TF_DOOR_ANY);
 }
 
@@ -240,7 +240,7 @@ bool square_isdoor(struct chunk *c, int y, int x)
  */
 bool square_isstairs(struct chunk *c, int y, int x)
 {
-	int feat = c->squares[y][x].feat;
+	int feat = sq_feat(c, y, x);
 	return tf_has(f_info[feat].flags, TF_STAIR);
 }
 
@@ -249,7 +249,7 @@ bool square_isstairs(struct chunk *c, int y, int x)
  */
 bool square_isupstairs(struct chunk*c, int y, int x)
 {
-	int feat = c->squares[y][x].feat;
+	int feat = sq_feat(c, y, x);
 	return tf_has(f_info[feat].flags, TF_UPSTAIR);
 }
 
@@ -258,7 +258,7 @@ bool square_isupstairs(struct chunk*c, int y, int x)
  */
 bool square_isdownstairs(struct chunk *c, int y, int x)
 {
-	int feat = c->squares[y][x].feat;
+	int feat = sq_feat(c, y, x);
 	return tf_has(f_info[feat].flags, TF_DOWNSTAIR);
 }
 
@@ -267,14 +267,14 @@ bool square_isdownstairs(struct chunk *c, int y, int x)
  */
 bool square_isshop(struct chunk *c, int y, int x)
 {
-	return feat_is_shop(c->squares[y][x].feat);
+	return feat_is_shop(sq_feat(c, y, x));
 }
 
 /**
  * True if the square contains the player
  */
 bool square_isplayer(struct chunk *c, int y, int x) {
-	return c->squares[y][x].mon < 0 ? TRUE : FALSE;
+	return sq_mon(c, y, x) < 0 ? TRUE : FALSE;
 }
 
 /**
@@ -290,7 +290,7 @@ bool square_isplayer(struct chunk *c, int y, int x) {
  */
 bool square_ismark(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_MARK);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_MARK);
 }
 
 /**
@@ -298,7 +298,7 @@ bool square_ismark(struct chunk *c, int y, int x) {
  */
 bool square_isglow(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_GLOW);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_GLOW);
 }
 
 /**
@@ -308,7 +308,7 @@ bool square_isglow(struct chunk *c, int y, int x) {
  */
 bool square_isvault(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_VAULT);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_VAULT);
 }
 
 /**
@@ -316,7 +316,7 @@ bool square_isvault(struct chunk *c, int y, int x) {
  */
 bool square_isroom(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_ROOM);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_ROOM);
 }
 
 /**
@@ -324,7 +324,7 @@ bool square_isroom(struct chunk *c, int y, int x) {
  */
 bool square_isseen(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_SEEN);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_SEEN);
 }
 
 /**
@@ -332,7 +332,7 @@ bool square_isseen(struct chunk *c, int y, int x) {
  */
 bool square_isview(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_VIEW);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_VIEW);
 }
 
 /**
@@ -340,7 +340,7 @@ bool square_isview(struct chunk *c, int y, int x) {
  */
 bool square_wasseen(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_WASSEEN);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_WASSEEN);
 }
 
 /**
@@ -348,7 +348,7 @@ bool square_wasseen(struct chunk *c, int y, int x) {
  */
 bool square_isdtrap(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_DTRAP);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_DTRAP);
 }
 
 /**
@@ -356,7 +356,7 @@ bool square_isdtrap(struct chunk *c, int y, int x) {
  */
 bool square_isfeel(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_FEEL);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_FEEL);
 }
 
 /**
@@ -364,7 +364,7 @@ bool square_isfeel(struct chunk *c, int y, int x) {
  */
 bool square_isdedge(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_DEDGE);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_DEDGE);
 }
 
 /**
@@ -372,7 +372,7 @@ bool square_isdedge(struct chunk *c, int y, int x) {
  */
 bool square_istrap(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_TRAP);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_TRAP);
 }
 
 /**
@@ -380,7 +380,7 @@ bool square_istrap(struct chunk *c, int y, int x) {
  */
 bool square_isinvis(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_INVIS);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_INVIS);
 }
 
 /**
@@ -388,7 +388,7 @@ bool square_isinvis(struct chunk *c, int y, int x) {
  */
 bool square_iswall_inner(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_WALL_INNER);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_WALL_INNER);
 }
 
 /**
@@ -396,7 +396,7 @@ bool square_iswall_inner(struct chunk *c, int y, int x) {
  */
 bool square_iswall_outer(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_WALL_OUTER);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_WALL_OUTER);
 }
 
 /**
@@ -404,7 +404,7 @@ bool square_iswall_outer(struct chunk *c, int y, int x) {
  */
 bool square_iswall_solid(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_WALL_SOLID);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_WALL_SOLID);
 }
 
 /**
@@ -412,7 +412,7 @@ bool square_iswall_solid(struct chunk *c, int y, int x) {
  */
 bool square_ismon_restrict(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_MON_RESTRICT);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_MON_RESTRICT);
 }
 
 /**
@@ -420,7 +420,7 @@ bool square_ismon_restrict(struct chunk *c, int y, int x) {
  */
 bool square_isno_teleport(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_NO_TELEPORT);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_NO_TELEPORT);
 }
 
 /**
@@ -428,7 +428,7 @@ bool square_isno_teleport(struct chunk *c, int y, int x) {
  */
 bool square_isno_map(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_NO_MAP);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_NO_MAP);
 }
 
 /**
@@ -436,7 +436,7 @@ bool square_isno_map(struct chunk *c, int y, int x) {
  */
 bool square_isno_esp(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_NO_ESP);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_NO_ESP);
 }
 
 /**
@@ -444,7 +444,7 @@ bool square_isno_esp(struct chunk *c, int y, int x) {
  */
 bool square_isproject(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return sqinfo_has(c->squares[y][x].info, SQUARE_PROJECT);
+	return sqinfo_has(sq_info(c, y, x), SQUARE_PROJECT);
 }
 
 
@@ -462,7 +462,7 @@ bool square_isproject(struct chunk *c, int y, int x) {
  * True if the square is open (a floor square not occupied by a monster).
  */
 bool square_isopen(struct chunk *c, int y, int x) {
-	return square_isfloor(c, y, x) && !c->squares[y][x].mon;
+	return square_isfloor(c, y, x) && !sq_mon(c, y, x);
 }
 
 /**
@@ -501,7 +501,7 @@ bool square_isdiggable(struct chunk *c, int y, int x) {
 bool square_is_monster_walkable(struct chunk *c, int y, int x)
 {
 	assert(square_in_bounds(c, y, x));
-	return feat_is_monster_walkable(c->squares[y][x].feat);
+	return feat_is_monster_walkable(sq_feat(c, y, x));
 }
 
 /**
@@ -509,7 +509,7 @@ bool square_is_monster_walkable(struct chunk *c, int y, int x)
  */
 bool square_ispassable(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return feat_is_passable(c->squares[y][x].feat);
+	return sq_plane_has(c, SQUARE_PLANE_PASSABLE, y, x);
 }
 
 /**
@@ -519,7 +519,7 @@ bool square_ispassable(struct chunk *c, int y, int x) {
  */
 bool square_isprojectable(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return feat_is_projectable(c->squares[y][x].feat);
+	return sq_plane_has(c, SQUARE_PLANE_PROJECT, y, x);
 }
 
 /**
@@ -529,7 +529,7 @@ bool square_isprojectable(struct chunk *c, int y, int x) {
  */
 bool square_iswall(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return !square_isprojectable(c, y, x);
+	return !sq_plane_has(c, SQUARE_PLANE_PROJECT, y, x);
 }
 
 /**
@@ -548,7 +548,7 @@ bool square_isstrongwall(struct chunk *c, int y, int x) {
  */
 bool square_isbright(struct chunk *c, int y, int x) {
 	assert(square_in_bounds(c, y, x));
-	return feat_is_bright(c->squares[y][x].feat);
+	return sq_plane_has(c, SQUARE_PLANE_BRIGHT, y, x);
 }
 
 bool square_iswarded(struct chunk *c, int y, int x)
@@ -564,12 +564,12 @@ bool square_canward(struct chunk *c, int y, int x)
 
 bool square_seemslikewall(struct chunk *c, int y, int x)
 {
-	return tf_has(f_info[c->squares[y][x].feat].flags, TF_ROCK);
+	return tf_has(f_info[sq_feat(c, y, x)].flags, TF_ROCK);
 }
 
 bool square_isinteresting(struct chunk *c, int y, int x)
 {
-	int f = c->squares[y][x].feat;
+	int f = sq_feat(c, y, x);
 	return tf_has(f_info[f].flags, TF_INTERESTING);
 }
 
@@ -682,7 +682,7 @@ struct feature *square_feat(struct chunk *c, int y, int x)
 	assert(y >= 0 && y < c->height);
 	assert(x >= 0 && x < c->width);
 
-	return &f_info[c->squares[y][x].feat];
+	return &f_info[sq_feat(c, y, x)];
 }
 
 /**
@@ -690,8 +690,8 @@ struct feature *square_feat(struct chunk *c, int y, int x)
  */
 struct monster *square_monster(struct chunk *c, int y, int x)
 {
-	if (c->squares[y][x].mon > 0) {
-		struct monster *mon = cave_monster(c, c->squares[y][x].mon);
+	if (sq_mon(c, y, x) > 0) {
+		struct monster *mon = cave_monster(c, sq_mon(c, y, x));
 		return mon->race ? mon : NULL;
 	}
 
@@ -702,7 +702,7 @@ struct monster *square_monster(struct chunk *c, int y, int x)
  * Get the top object of a pile on the current level by its position.
  */
 struct object *square_object(struct chunk *c, int y, int x) {
-	return c->squares[y][x].obj;
+	return sq_obj(c, y, x);
 }
 
 /**
@@ -716,7 +716,7 @@ bool square_holds_object(struct chunk *c, int y, int x, struct object *obj) {
  * Excise an object from a floor pile, leaving it orphaned.
  */
 void square_excise_object(struct chunk *c, int y, int x, struct object *obj) {
-	pile_excise(&c->squares[y][x].obj, obj);
+	pile_excise(&sq_obj(c, y, x), obj);
 }
 
 /**
@@ -724,7 +724,7 @@ void square_excise_object(struct chunk *c, int y, int x, struct object *obj) {
  */
 void square_excise_pile(struct chunk *c, int y, int x) {
 	object_pile_free(square_object(c, y, x));
-	c->squares[y][x].obj = NULL;
+	sq_obj(c, y, x) = NULL;
 }
 
 
@@ -736,7 +736,7 @@ void square_excise_pile(struct chunk *c, int y, int x) {
  */
 void square_set_feat(struct chunk *c, int y, int x, int feat)
 {
-	int current_feat = c->squares[y][x].feat;
+	int current_feat = sq_feat(c, y, x);
 
 	assert(c);
 	assert(y >= 0 && y < c->height);
@@ -747,7 +747,8 @@ void square_set_feat(struct chunk *c, int y, int x, int feat)
 	if (feat) c->feat_count[feat]++;
 
 	/* Make the change */
-	c->squares[y][x].feat = feat;
+	sq_feat(c, y, x) = feat;
+	square_update_planes(c, y, x);
 
 	/* Make the new terrain feel at home */
 	if (character_dungeon) {
@@ -759,9 +760,46 @@ void square_set_feat(struct chunk *c, int y, int x, int feat)
 		square_light_spot(c, y, x);
 	} else {
 		/* Make sure no incorrect wall flags set for dungeon generation */
-		sqinfo_off(c->squares[y][x].info, SQUARE_WALL_INNER);
-		sqinfo_off(c->squares[y][x].info, SQUARE_WALL_OUTER);
-		sqinfo_off(c->squares[y][x].info, SQUARE_WALL_SOLID);
+		sqinfo_off(sq_info(c, y, x), SQUARE_WALL_INNER);
+		sqinfo_off(sq_info(c, y, x), SQUARE_WALL_OUTER);
+		sqinfo_off(sq_info(c, y, x), SQUARE_WALL_SOLID);
+	}
+}
+
+/**
+ * Bring the terrain bit planes for a square, and its place in the list of
+ * floors, into line with its feature.
+ *
+ * Code which writes sq_feat() directly rather than through square_set_feat()
+ * must call this afterwards.
+ */
+void square_update_planes(struct chunk *c, int y, int x)
+{
+	struct feature *f_ptr = &f_info[sq_feat(c, y, x)];
+	int flags[SQUARE_PLANE_MAX] = {
+		TF_PASSABLE, TF_PROJECT, TF_BRIGHT, TF_NO_FLOW
+	};
+	int i, n = square_idx(c, y, x);
+
+	/* Any cached flow fields may now be wrong */
+	c->terrain_stamp++;
+
+	/* Keep the list of floors up to date */
+	if (tf_has(f_ptr->flags, TF_FLOOR) && !c->floor_slot[n]) {
+		c->floor_list[c->floor_n++] = n;
+		c->floor_slot[n] = c->floor_n;
+	} else if (!tf_has(f_ptr->flags, TF_FLOOR) && c->floor_slot[n]) {
+		int last = c->floor_list[--c->floor_n];
+		c->floor_list[c->floor_slot[n] - 1] = last;
+		c->floor_slot[last] = c->floor_slot[n];
+		c->floor_slot[n] = 0;
+	}
+
+	for (i = 0; i < SQUARE_PLANE_MAX; i++) {
+		if (tf_has(f_ptr->flags, flags[i]))
+			sq_plane_word(c, i, y, x) |= sq_plane_bit(x);
+		else
+			sq_plane_word(c, i, y, x) &= ~sq_plane_bit(x);
 	}
 }
 
@@ -880,9 +918,9 @@ void square_remove_ward(struct chunk *c, int y, int x)
  */
 void square_upgrade_mineral(struct chunk *c, int y, int x)
 {
-	if (c->squares[y][x].feat == FEAT_MAGMA)
+	if (sq_feat(c, y, x) == FEAT_MAGMA)
 		square_set_feat(c, y, x, FEAT_MAGMA_K);
-	if (c->squares[y][x].feat == FEAT_QUARTZ)
+	if (sq_feat(c, y, x) == FEAT_QUARTZ)
 		square_set_feat(c, y, x, FEAT_QUARTZ_K);
 }
 
@@ -897,18 +935,18 @@ void square_force_floor(struct chunk *c, int y, int x) {
 
 int square_shopnum(struct chunk *c, int y, int x) {
 	if (square_isshop(c, y, x))
-		return f_info[c->squares[y][x].feat].shopnum;
+		return f_info[sq_feat(c, y, x)].shopnum;
 	return -1;
 }
 
 int square_digging(struct chunk *c, int y, int x) {
 	if (square_isdiggable(c, y, x))
-		return f_info[c->squares[y][x].feat].dig;
+		return f_info[sq_feat(c, y, x)].dig;
 	return 0;
 }
 
 const char *square_apparent_name(struct chunk *c, struct player *p, int y, int x) {
-	int f = f_info[c->squares[y][x].feat].mimic;
+	int f = f_info[sq_feat(c, y, x)].mimic;
 
 	if (!square_ismark(c, y, x) && !square_isseen(c, y, x))
 		return "unknown grid";
@@ -78,8 +78,11 @@ int distance(int y1, int x1, int y2, int x2)
  * are "viewable" by the player, which is used for many things, such as
  * determining which grids are illuminated by the player's torch, and which
  * grids and monsters can be "seen" by the player, etc).
+ *
+ * This is the direct computation; offsets within the precomputed ray table
+ * are handled by los() without it.
  */
-bool los(struct chunk *c, int y1, int x1, int y2, int x2)
+static bool los_aux(struct chunk *c, int y1, int x1, int y2, int x2)
 {
 	/* Delta */
 	int dx, dy;
@@ -246,6 +249,283 @@ bool los(struct chunk *c, int y1, int x1, int y2, int x2)
 	return (TRUE);
 }
 
+/**
+ * ------------------------------------------------------------------------
+ * Precomputed LOS rays
+ *
+ * The grids los_aux() tests depend only on the offset between the two end
+ * points, so for every offset with both components within max_sight they
+ * are traced once at startup and stored, in the order los_aux() tests them,
+ * as offsets from the start grid.  LOS then only needs a walk along the
+ * stored ray, stopping at the first grid which is not projectable.
+ * ------------------------------------------------------------------------ */
+
+/**
+ * Largest radius the ray table will cover, bounding the table size
+ */
+#define LOS_RADIUS_MAX	100
+
+/**
+ * One grid tested along a ray, as an offset from the start grid
+ */
+struct los_step {
+	s16b y;
+	s16b x;
+};
+
+/**
+ * The precomputed ray for one offset
+ */
+struct los_ray {
+	u32b first;			/**< Index of the first step in los_steps */
+	u16b len;			/**< Number of steps */
+	bool knight;		/**< Is there a "knight's move" shortcut grid? */
+	struct los_step k;	/**< The shortcut grid, which gives LOS if open */
+};
+
+static int los_radius;
+static struct los_ray *los_rays;
+static struct los_step *los_steps;
+
+/**
+ * Record the grids los_aux() would test for the offset (dy, dx), filling in
+ * the knight's move part of the ray and returning the number of steps.
+ */
+static int los_trace(int dy, int dx, struct los_step *steps,
+					 struct los_ray *ray)
+{
+	int ax = ABS(dx), ay = ABS(dy);
+	int sx = (dx < 0) ? -1 : 1, sy = (dy < 0) ? -1 : 1;
+	int qx, qy, tx, ty, f1, f2, m;
+	int n = 0;
+
+	ray->knight = FALSE;
+
+	/* Adjacent (or identical) grids have nothing in between */
+	if ((ax < 2) && (ay < 2)) return 0;
+
+	/* Directly South/North */
+	if (!dx) {
+		for (ty = sy; ty != dy; ty += sy) {
+			steps[n].y = ty;
+			steps[n++].x = 0;
+		}
+		return n;
+	}
+
+	/* Directly East/West */
+	if (!dy) {
+		for (tx = sx; tx != dx; tx += sx) {
+			steps[n].y = 0;
+			steps[n++].x = tx;
+		}
+		return n;
+	}
+
+	/* Vertical and horizontal "knights" */
+	if ((ax == 1) && (ay == 2)) {
+		ray->knight = TRUE;
+		ray->k.y = sy;
+		ray->k.x = 0;
+	} else if ((ay == 1) && (ax == 2)) {
+		ray->knight = TRUE;
+		ray->k.y = 0;
+		ray->k.x = sx;
+	}
+
+	/* Scale factors, as in los_aux() */
+	f2 = (ax * ay);
+	f1 = f2 << 1;
+
+	if (ax >= ay) {
+		/* Travel horizontally */
+		qy = ay * ay;
+		m = qy << 1;
+		tx = sx;
+		if (qy == f2) {
+			ty = sy;
+			qy -= f1;
+		} else {
+			ty = 0;
+		}
+
+		while (dx - tx) {
+			steps[n].y = ty;
+			steps[n++].x = tx;
+			qy += m;
+			if (qy < f2) {
+				tx += sx;
+			} else if (qy > f2) {
+				ty += sy;
+				steps[n].y = ty;
+				steps[n++].x = tx;
+				qy -= f1;
+				tx += sx;
+			} else {
+				ty += sy;
+				qy -= f1;
+				tx += sx;
+			}
+		}
+	} else {
+		/* Travel vertically */
+		qx = ax * ax;
+		m = qx << 1;
+		ty = sy;
+		if (qx == f2) {
+			tx = sx;
+			qx -= f1;
+		} else {
+			tx = 0;
+		}
+
+		while (dy - ty) {
+			steps[n].y = ty;
+			steps[n++].x = tx;
+			qx += m;
+			if (qx < f2) {
+				ty += sy;
+			} else if (qx > f2) {
+				tx += sx;
+				steps[n].y = ty;
+				steps[n++].x = tx;
+				qx -= f1;
+				ty += sy;
+			} else {
+				tx += sx;
+				qx -= f1;
+				ty += sy;
+			}
+		}
+	}
+
+	return n;
+}
+
+/**
+ * Get the precomputed ray for an offset, or NULL if it is out of range
+ */
+static const struct los_ray *los_ray_get(int dy, int dx)
+{
+	int side = 2 * los_radius + 1;
+
+	if (!los_rays || (ABS(dy) > los_radius) || (ABS(dx) > los_radius))
+		return NULL;
+
+	return &los_rays[(dy + los_radius) * side + (dx + los_radius)];
+}
+
+/**
+ * Walk a precomputed ray from (y, x)
+ */
+static bool los_ray_clear(struct chunk *c, int y, int x,
+						  const struct los_ray *ray)
+{
+	const struct los_step *step = &los_steps[ray->first];
+	int i;
+
+	/* The knight's move shortcut */
+	if (ray->knight && sq_plane_has(c, SQUARE_PLANE_PROJECT, y + ray->k.y,
+									x + ray->k.x))
+		return TRUE;
+
+	/* Check for walls along the ray against the projectable plane */
+	for (i = 0; i < ray->len; i++, step++)
+		if (!sq_plane_has(c, SQUARE_PLANE_PROJECT, y + step->y, x + step->x))
+			return FALSE;
+
+	return TRUE;
+}
+
+/**
+ * Determine whether there is line of sight between two grids; see
+ * los_aux() for the algorithm.
+ */
+bool los(struct chunk *c, int y1, int x1, int y2, int x2)
+{
+	const struct los_ray *ray = los_ray_get(y2 - y1, x2 - x1);
+
+	if (ray)
+		return los_ray_clear(c, y1, x1, ray);
+
+	return los_aux(c, y1, x1, y2, x2);
+}
+
+/**
+ * Determine line of sight from one grid to each of a set of grids, setting
+ * out[i] to los() from the start grid to targets[i].
+ */
+void los_many(struct chunk *c, struct loc from, const struct loc *targets,
+			  int n, bool *out)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		const struct los_ray *ray = los_ray_get(targets[i].y - from.y,
+												targets[i].x - from.x);
+		if (ray)
+			out[i] = los_ray_clear(c, from.y, from.x, ray);
+		else
+			out[i] = los_aux(c, from.y, from.x, targets[i].y, targets[i].x);
+	}
+}
+
+/**
+ * Build the ray table for all offsets within max_sight
+ */
+static void init_los_rays(void)
+{
+	int side, dy, dx;
+	u32b total = 0;
+	struct los_step *scratch;
+
+	los_radius = MIN(z_info->max_sight, LOS_RADIUS_MAX);
+	side = 2 * los_radius + 1;
+	los_rays = mem_zalloc(side * side * sizeof(*los_rays));
+	scratch = mem_zalloc(4 * (los_radius + 1) * sizeof(*scratch));
+
+	/* Size the rays */
+	for (dy = -los_radius; dy <= los_radius; dy++) {
+		for (dx = -los_radius; dx <= los_radius; dx++) {
+			struct los_ray *ray = &los_rays[(dy + los_radius) * side +
+											(dx + los_radius)];
+			ray->first = total;
+			ray->len = los_trace(dy, dx, scratch, ray);
+			total += ray->len;
+		}
+	}
+
+	/* Fill in the steps */
+	los_steps = mem_zalloc(MAX(total, 1) * sizeof(*los_steps));
+	for (dy = -los_radius; dy <= los_radius; dy++) {
+		for (dx = -los_radius; dx <= los_radius; dx++) {
+			struct los_ray *ray = &los_rays[(dy + los_radius) * side +
+											(dx + los_radius)];
+			los_trace(dy, dx, &los_steps[ray->first], ray);
+		}
+	}
+
+	mem_free(scratch);
+}
+
+/**
+ * Free the ray table
+ */
+static void cleanup_los_rays(void)
+{
+	mem_free(los_rays);
+	mem_free(los_steps);
+	los_rays = NULL;
+	los_steps = NULL;
+	los_radius = 0;
+}
+
+struct init_module view_module = {
+	.name = "cave/view",
+	.init = init_los_rays,
+	.cleanup = cleanup_los_rays
+};
+
 /**
  * The comments below are still predominantly true, and have been left
  * (slightly modified for accuracy) for historical and nostalgic reasons.
@@ -287,8 +567,8 @@ bool los(struct chunk *c, int y1, int x1, int y2, int x2)
  * twice is inconsequential compared to the speed increase.
  *
  * Several pieces of information about each cave grid are stored in the
- * info field of the "cave->squares" array, which is a special array of
- * bitflags.
+ * info plane of the chunk (see "sq_info()"), which holds a special array of
+ * bitflags for each grid.
  *
  * The "SQUARE_ROOM" flag is used to determine which grids are part of "rooms", 
  * and thus which grids are affected by "illumination" spells.
@@ -440,42 +720,109 @@ bool los(struct chunk *c, int y1, int x1, int y2, int x2)
  *
  */
 
+/**
+ * Make sure the chunk has its list of viewed grids.
+ *
+ * The first time round, the list is filled from the whole grid, to pick up
+ * any view flags which came with the chunk (from a savefile, for example).
+ * After that every grid which gets SQUARE_VIEW goes on the list, so the
+ * view can be cleared without looking at the rest of the level.
+ */
+static void view_list_init(struct chunk *c)
+{
+	int n;
+	int side = 2 * z_info->max_sight + 1;
+
+	if (c->view_g)
+		return;
+
+	/* Every viewed grid is within max_sight of the player */
+	c->view_max = MAX(side * side, 1);
+	c->view_g = mem_zalloc(c->view_max * sizeof(struct loc));
+	c->view_old = mem_zalloc(c->view_max * sizeof(struct loc));
+	c->view_n = 0;
+
+	for (n = 0; n < c->height * c->width; n++) {
+		if (!sqinfo_has(c->info + n * SQUARE_SIZE, SQUARE_VIEW))
+			continue;
+
+		/* Stale flags from a different view can't be listed; just drop them */
+		if (c->view_n == c->view_max) {
+			sqinfo_off(c->info + n * SQUARE_SIZE, SQUARE_VIEW);
+			sqinfo_off(c->info + n * SQUARE_SIZE, SQUARE_SEEN);
+			continue;
+		}
+		c->view_g[c->view_n++] = loc(n % c->width, n / c->width);
+	}
+}
+
+/**
+ * Add a grid to the view, listing it if it is new, and waking any parked
+ * monster there
+ */
+static void view_add(struct chunk *c, int y, int x)
+{
+	int m_idx = sq_mon(c, y, x);
+
+	if (square_isview(c, y, x))
+		return;
+
+	if (m_idx > 0 && c->dormant_slot[m_idx])
+		cave_monster_unpark(c, m_idx);
+
+	sqinfo_on(sq_info(c, y, x), SQUARE_VIEW);
+	assert(c->view_n < c->view_max);
+	c->view_g[c->view_n++] = loc(x, y);
+}
+
 /**
  * Forget the "SQUARE_VIEW" grids, redrawing as needed
  */
 void forget_view(struct chunk *c)
 {
-	int x, y;
+	int i;
 
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
-			if (!square_isview(c, y, x))
-				continue;
-			sqinfo_off(c->squares[y][x].info, SQUARE_VIEW);
-			sqinfo_off(c->squares[y][x].info, SQUARE_SEEN);
-			square_light_spot(c, y, x);
-		}
+	view_list_init(c);
+
+	for (i = 0; i < c->view_n; i++) {
+		int y = c->view_g[i].y;
+		int x = c->view_g[i].x;
+
+		sqinfo_off(sq_info(c, y, x), SQUARE_VIEW);
+		sqinfo_off(sq_info(c, y, x), SQUARE_SEEN);
+		square_light_spot(c, y, x);
 	}
+
+	c->view_n = 0;
 }
 
 
 
 /**
- * Mark the currently seen grids, then wipe in preparation for recalculating
+ * Mark the currently seen grids, then wipe in preparation for recalculating.
+ * The old list of viewed grids is kept in view_old for update_view().
  */
-static void mark_wasseen(struct chunk *c) 
+static void mark_wasseen(struct chunk *c)
 {
-	int x, y;
-	/* Save the old "view" grids for later */
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
-			if (square_isseen(c, y, x))
-				sqinfo_on(c->squares[y][x].info, SQUARE_WASSEEN);
-			sqinfo_off(c->squares[y][x].info, SQUARE_VIEW);
-			sqinfo_off(c->squares[y][x].info, SQUARE_SEEN);
-		}
+	int i;
+	struct loc *swap;
+
+	for (i = 0; i < c->view_n; i++) {
+		bitflag *info = sq_info(c, c->view_g[i].y, c->view_g[i].x);
+		if (sqinfo_has(info, SQUARE_SEEN))
+			sqinfo_on(info, SQUARE_WASSEEN);
+		sqinfo_off(info, SQUARE_VIEW);
+		sqinfo_off(info, SQUARE_SEEN);
 	}
+
+	/* Start a new list */
+	swap = c->view_old;
+	c->view_old = c->view_g;
+	c->view_g = swap;
+	c->view_old_n = c->view_n;
+	c->view_n = 0;
 }
+
 /**
  * Like it says on the tin
  */
@@ -483,43 +830,47 @@ static void add_monster_lights(struct chunk *c, struct loc from)
 {
 	int i, j, k;
 
-	/* Scan monster list and add monster lights */
-	for (k = 1; k < cave_monster_max(c); k++) {
-		/* Check the k'th monster */
-		struct monster *m = cave_monster(c, k);
+	/* Scan the light carrying monsters */
+	for (k = 0; k < c->light_n; k++) {
+		struct monster *m = cave_monster(c, c->light_mon[k]);
 
-		bool in_los = los(c, from.y, from.x, m->fy, m->fx);
+		/* The monster, then the 3x3 box centered on it */
+		struct loc grids[10];
+		bool in_los[10];
+		int n = 0;
 
-		/* Skip dead monsters */
-		if (!m->race)
+		/* Skip monsters too far away to light a grid in sight */
+		if (distance(from.y, from.x, m->fy, m->fx) > z_info->max_sight + 2)
 			continue;
 
-		/* Skip monsters not carrying light */
-		if (!rf_has(m->race->flags, RF_HAS_LIGHT))
-			continue;
+		/* Check LOS to everything at once */
+		grids[n++] = loc(m->fx, m->fy);
+		for (i = -1; i <= 1; i++)
+			for (j = -1; j <= 1; j++)
+				grids[n++] = loc(m->fx + j, m->fy + i);
+		los_many(c, from, grids, n, in_los);
 
 		/* Light a 3x3 box centered on the monster */
-		for (i = -1; i <= 1; i++)
-			for (j = -1; j <= 1; j++) {
-				int sy = m->fy + i;
-				int sx = m->fx + j;
+		for (i = 1; i < n; i++) {
+			int sy = grids[i].y;
+			int sx = grids[i].x;
 				
-				/* If the monster isn't visible we can only light open tiles */
-				if (!in_los && !square_isprojectable(c, sy, sx))
-					continue;
+			/* If the monster isn't visible we can only light open tiles */
+			if (!in_los[0] && !square_isprojectable(c, sy, sx))
+				continue;
 
-				/* If the tile is too far away we won't light it */
-				if (distance(from.y, from.x, sy, sx) > z_info->max_sight)
-					continue;
+			/* If the tile is too far away we won't light it */
+			if (distance(from.y, from.x, sy, sx) > z_info->max_sight)
+				continue;
 				
-				/* If the tile itself isn't in LOS, don't light it */
-				if (!los(c, from.y, from.x, sy, sx))
-					continue;
+			/* If the tile itself isn't in LOS, don't light it */
+			if (!in_los[i])
+				continue;
 
-				/* Mark the square lit and seen */
-				sqinfo_on(c->squares[sy][sx].info, SQUARE_VIEW);
-				sqinfo_on(c->squares[sy][sx].info, SQUARE_SEEN);
-			}
+			/* Mark the square lit and seen */
+			view_add(c, sy, sx);
+			sqinfo_on(sq_info(c, sy, sx), SQUARE_SEEN);
+		}
 	}
 }
 
@@ -529,13 +880,13 @@ static void add_monster_lights(struct chunk *c, struct loc from)
 static void update_one(struct chunk *c, int y, int x, int blind)
 {
 	if (blind)
-		sqinfo_off(c->squares[y][x].info, SQUARE_SEEN);
+		sqinfo_off(sq_info(c, y, x), SQUARE_SEEN);
 
 	/* Square went from unseen -> seen */
 	if (square_isseen(c, y, x) && !square_wasseen(c, y, x)) {
 		if (square_isfeel(c, y, x)) {
 			c->feeling_squares++;
-			sqinfo_off(c->squares[y][x].info, SQUARE_FEEL);
+			sqinfo_off(sq_info(c, y, x), SQUARE_FEEL);
 			/* Don't display feeling if it will display for the new level */
 			if ((c->feeling_squares == z_info->feeling_need) &&
 				!player->upkeep->only_partial)
@@ -550,7 +901,7 @@ static void update_one(struct chunk *c, int y, int x, int blind)
 	if (!square_isseen(c, y, x) && square_wasseen(c, y, x))
 		square_light_spot(c, y, x);
 
-	sqinfo_off(c->squares[y][x].info, SQUARE_WASSEEN);
+	sqinfo_off(sq_info(c, y, x), SQUARE_WASSEEN);
 }
 
 /**
@@ -563,10 +914,10 @@ static void become_viewable(struct chunk *c, int y, int x, int lit, int py, int
 	if (square_isview(c, y, x))
 		return;
 
-	sqinfo_on(c->squares[y][x].info, SQUARE_VIEW);
+	view_add(c, y, x);
 
 	if (lit)
-		sqinfo_on(c->squares[y][x].info, SQUARE_SEEN);
+		sqinfo_on(sq_info(c, y, x), SQUARE_SEEN);
 
 	if (square_isglow(c, y, x)) {
 		if (square_iswall(c, y, x)) {
@@ -577,7 +928,7 @@ static void become_viewable(struct chunk *c, int y, int x, int lit, int py, int
 			yc = (y < py) ? (y + 1) : (y > py) ? (y - 1) : y;
 		}
 		if (square_isglow(c, yc, xc))
-			sqinfo_on(c->squares[y][x].info, SQUARE_SEEN);
+			sqinfo_on(sq_info(c, y, x), SQUARE_SEEN);
 	}
 }
 
@@ -596,14 +947,6 @@ static void update_view_one(struct chunk *c, int y, int x, int radius, int py, i
 	if (d > z_info->max_sight)
 		return;
 
-	/* Light squares with adjacent bright terrain */
-	for (dir = 0; dir < 8; dir++) {
-		if (!square_in_bounds(c, y + ddy_ddd[dir], x + ddx_ddd[dir]))
-			continue;
-		if (square_isbright(c, y + ddy_ddd[dir], x + ddx_ddd[dir]))
-			lit = TRUE;
-	}
-
 	/* Special case for wall lighting. If we are a wall and the square in
 	 * the direction of the player is in LOS, we are in LOS. This avoids
 	 * situations like:
@@ -650,20 +993,36 @@ static void update_view_one(struct chunk *c, int y, int x, int radius, int py, i
 		}
 	}
 
+	/* Squares out of LOS need no lighting checks */
+	if (!los(c, py, px, yc, xc))
+		return;
 
-	if (los(c, py, px, yc, xc))
-		become_viewable(c, y, x, lit, py, px);
+	/* Light squares with adjacent bright terrain */
+	for (dir = 0; dir < 8 && !lit; dir++) {
+		if (!square_in_bounds(c, y + ddy_ddd[dir], x + ddx_ddd[dir]))
+			continue;
+		if (square_isbright(c, y + ddy_ddd[dir], x + ddx_ddd[dir]))
+			lit = TRUE;
+	}
+
+	become_viewable(c, y, x, lit, py, px);
 }
 
 /**
  * Update the player's current view
+ *
+ * Only grids within max_sight of the player can come into view, so only
+ * those are tested, and only grids on the new or old view lists can have
+ * changed state, so only those are completed.
  */
 void update_view(struct chunk *c, struct player *p)
 {
-	int x, y;
+	int x, y, i;
+	int y1, x1, y2, x2;
 
 	int radius;
 
+	view_list_init(c);
 	mark_wasseen(c);
 
 	/* Extract "radius" value */
@@ -675,19 +1034,32 @@ void update_view(struct chunk *c, struct player *p)
 	add_monster_lights(c, loc(p->px, p->py));
 
 	/* Assume we can view the player grid */
-	sqinfo_on(c->squares[p->py][p->px].info, SQUARE_VIEW);
+	view_add(c, p->py, p->px);
 	if (radius > 0 || square_isglow(c, p->py, p->px))
-		sqinfo_on(c->squares[p->py][p->px].info, SQUARE_SEEN);
+		sqinfo_on(sq_info(c, p->py, p->px), SQUARE_SEEN);
+
+	/* Bound the grids within sight */
+	y1 = MAX(p->py - z_info->max_sight, 0);
+	x1 = MAX(p->px - z_info->max_sight, 0);
+	y2 = MIN(p->py + z_info->max_sight, c->height - 1);
+	x2 = MIN(p->px + z_info->max_sight, c->width - 1);
 
 	/* View squares we have LOS to */
-	for (y = 0; y < c->height; y++)
-		for (x = 0; x < c->width; x++)
+	for (y = y1; y <= y2; y++)
+		for (x = x1; x <= x2; x++)
 			update_view_one(c, y, x, radius, p->py, p->px);
 
-	/* Complete the algorithm */
-	for (y = 0; y < c->height; y++)
-		for (x = 0; x < c->width; x++)
+	/* Complete the algorithm for the grids now in view */
+	for (i = 0; i < c->view_n; i++)
+		update_one(c, c->view_g[i].y, c->view_g[i].x, p->timed[TMD_BLIND]);
+
+	/* ... and for the grids which have left the view */
+	for (i = 0; i < c->view_old_n; i++) {
+		y = c->view_old[i].y;
+		x = c->view_old[i].x;
+		if (!square_isview(c, y, x))
 			update_one(c, y, x, p->timed[TMD_BLIND]);
+	}
 }
 
 
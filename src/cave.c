@@ -116,22 +116,54 @@ void set_terrain(void)
  * Allocate a new chunk of the world
  */
 struct chunk *cave_new(int height, int width) {
-	int y, x;
+	size_t size = height * width;
+	int i;
 
 	struct chunk *c = mem_zalloc(sizeof *c);
 	c->height = height;
 	c->width = width;
 	c->feat_count = mem_zalloc((z_info->f_max + 1) * sizeof(int));
 
-	c->squares = mem_zalloc(c->height * sizeof(struct square*));
-	for (y = 0; y < c->height; y++) {
-		c->squares[y] = mem_zalloc(c->width * sizeof(struct square));
-		for (x = 0; x < c->width; x++)
-			c->squares[y][x].info = mem_zalloc(SQUARE_SIZE * sizeof(bitflag));
-	}
+	c->feat = mem_zalloc(size * sizeof(byte));
+	c->info = mem_zalloc(size * SQUARE_SIZE * sizeof(bitflag));
+	c->cost = mem_zalloc(size * sizeof(byte));
+	c->when = mem_zalloc(size * sizeof(byte));
+	c->mon = mem_zalloc(size * sizeof(s16b));
+	c->obj = mem_zalloc(size * sizeof(struct object *));
+	c->trap = mem_zalloc(size * sizeof(struct trap *));
+
+	c->plane_stride = (width + 31) / 32;
+	for (i = 0; i < SQUARE_PLANE_MAX; i++)
+		c->plane[i] = mem_zalloc(height * c->plane_stride * sizeof(u32b));
+	c->redraw = mem_zalloc(height * c->plane_stride * sizeof(u32b));
+	c->floor_list = mem_zalloc(size * sizeof(int));
+	c->floor_slot = mem_zalloc(size * sizeof(int));
+	c->redraw_min = loc(width, height);
+	c->redraw_max = loc(-1, -1);
 
 	c->monsters = mem_zalloc(z_info->level_monster_max *sizeof(struct monster));
+	c->mon_known = mem_zalloc(z_info->level_monster_max *
+							  sizeof(struct monster_known_pstate));
+	c->mon_free = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
 	c->mon_max = 1;
+
+	c->bucket_h = (height + MON_BUCKET_SIZE - 1) >> MON_BUCKET_SHIFT;
+	c->bucket_w = (width + MON_BUCKET_SIZE - 1) >> MON_BUCKET_SHIFT;
+	c->mon_bucket = mem_zalloc(c->bucket_h * c->bucket_w * sizeof(s16b));
+	c->mon_next = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->mon_prev = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->light_mon = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->light_slot = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->energy_head = mem_zalloc(MON_ENERGY_MAX * sizeof(s16b));
+	c->energy_next = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->energy_prev = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->mon_handled = mem_zalloc(z_info->level_monster_max * sizeof(u32b));
+	c->mon_ready = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->sched_turn = 1;
+	c->dormant_mon = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->dormant_slot = mem_zalloc(z_info->level_monster_max * sizeof(s16b));
+	c->dormant_turn = mem_zalloc(z_info->level_monster_max * sizeof(u32b));
+	c->dormant_anchor = loc(-1, -1);
 	c->mon_current = -1;
 
 	c->created_at = turn;
@@ -142,22 +174,55 @@ struct chunk *cave_new(int height, int width) {
  * Free a chunk
  */
 void cave_free(struct chunk *c) {
-	int y, x;
+	int y, x, i;
 
 	for (y = 0; y < c->height; y++) {
 		for (x = 0; x < c->width; x++) {
-			mem_free(c->squares[y][x].info);
-			if (c->squares[y][x].trap)
+			if (sq_trap(c, y, x))
 				square_free_trap(c, y, x);
-			if (c->squares[y][x].obj)
-				object_pile_free(c->squares[y][x].obj);
+			if (sq_obj(c, y, x))
+				object_pile_free(sq_obj(c, y, x));
 		}
-		mem_free(c->squares[y]);
 	}
-	mem_free(c->squares);
+
+	mem_free(c->feat);
+	mem_free(c->info);
+	mem_free(c->cost);
+	mem_free(c->when);
+	mem_free(c->mon);
+	mem_free(c->obj);
+	mem_free(c->trap);
+	for (i = 0; i < SQUARE_PLANE_MAX; i++)
+		mem_free(c->plane[i]);
+	for (i = 0; i < FLOW_MAX; i++)
+		mem_free(c->flows[i].dist);
+	mem_free(c->flow_queue);
+	mem_free(c->flow_seeds);
+	mem_free(c->flow_count);
+	mem_free(c->flow_done);
+	mem_free(c->redraw);
+	mem_free(c->floor_list);
+	mem_free(c->floor_slot);
+	mem_free(c->view_g);
+	mem_free(c->view_old);
 
 	mem_free(c->feat_count);
 	mem_free(c->monsters);
+	mem_free(c->mon_known);
+	mem_free(c->mon_free);
+	mem_free(c->mon_bucket);
+	mem_free(c->mon_next);
+	mem_free(c->mon_prev);
+	mem_free(c->light_mon);
+	mem_free(c->light_slot);
+	mem_free(c->energy_head);
+	mem_free(c->energy_next);
+	mem_free(c->energy_prev);
+	mem_free(c->mon_handled);
+	mem_free(c->mon_ready);
+	mem_free(c->dormant_mon);
+	mem_free(c->dormant_slot);
+	mem_free(c->dormant_turn);
 	if (c->name)
 		string_free(c->name);
 	mem_free(c);
@@ -214,6 +279,14 @@ struct monster *cave_monster(struct chunk *c, int idx) {
 	return &c->monsters[idx];
 }
 
+/**
+ * Get what a monster on the current level knows of the player.
+ */
+struct monster_known_pstate *cave_monster_known(struct chunk *c, int idx) {
+	if (idx <= 0) return NULL;
+	return &c->mon_known[idx];
+}
+
 /**
  * The maximum number of monsters allowed in the level.
  */
@@ -228,6 +301,465 @@ int cave_monster_count(struct chunk *c) {
 	return c->mon_cnt;
 }
 
+/**
+ * The block of the monster spatial index holding a grid
+ */
+static int cave_monster_bucket(struct chunk *c, int y, int x)
+{
+	return (y >> MON_BUCKET_SHIFT) * c->bucket_w + (x >> MON_BUCKET_SHIFT);
+}
+
+/**
+ * Add a monster to the spatial index at its current location.
+ *
+ * Anything which puts a monster on a level or moves it must keep the index
+ * up to date: remove the monster, change fy and fx, then add it again.
+ */
+void cave_monster_index_add(struct chunk *c, int m_idx)
+{
+	struct monster *mon = cave_monster(c, m_idx);
+	int b = cave_monster_bucket(c, mon->fy, mon->fx);
+	int head = c->mon_bucket[b];
+
+	c->mon_prev[m_idx] = 0;
+	c->mon_next[m_idx] = head;
+	if (head)
+		c->mon_prev[head] = m_idx;
+	c->mon_bucket[b] = m_idx;
+}
+
+/**
+ * Remove a monster from the spatial index; it must still be where it was
+ * when it was added.
+ */
+void cave_monster_index_remove(struct chunk *c, int m_idx)
+{
+	struct monster *mon = cave_monster(c, m_idx);
+	int prev = c->mon_prev[m_idx];
+	int next = c->mon_next[m_idx];
+
+	if (prev)
+		c->mon_next[prev] = next;
+	else
+		c->mon_bucket[cave_monster_bucket(c, mon->fy, mon->fx)] = next;
+
+	if (next)
+		c->mon_prev[next] = prev;
+
+	c->mon_prev[m_idx] = c->mon_next[m_idx] = 0;
+}
+
+/**
+ * Start iterating over the living monsters in a rectangle of grids, with the
+ * race flag `flag` (RF_NONE for any monster).
+ *
+ * Monsters come back block by block, not in index order.  The monster just
+ * returned may be deleted during the iteration, but no other monster may be
+ * deleted or moved.
+ */
+void cave_monster_iter_rect(struct monster_iter *iter, struct chunk *c,
+							int y1, int x1, int y2, int x2, int flag)
+{
+	iter->c = c;
+	iter->y1 = MAX(y1, 0);
+	iter->x1 = MAX(x1, 0);
+	iter->y2 = MIN(y2, c->height - 1);
+	iter->x2 = MIN(x2, c->width - 1);
+	iter->r = -1;
+	iter->flag = flag;
+	iter->view = FALSE;
+
+	/* Start just before the first block */
+	iter->by = iter->y1 >> MON_BUCKET_SHIFT;
+	iter->bx = (iter->x1 >> MON_BUCKET_SHIFT) - 1;
+	iter->m_idx = 0;
+
+	/* Empty rectangle */
+	if (iter->y1 > iter->y2 || iter->x1 > iter->x2)
+		iter->by = c->bucket_h;
+}
+
+/**
+ * Start iterating over the monsters within distance r of (y, x)
+ */
+void cave_monster_iter_near(struct monster_iter *iter, struct chunk *c,
+							int y, int x, int r, int flag)
+{
+	cave_monster_iter_rect(iter, c, y - r, x - r, y + r, x + r, flag);
+	iter->y = y;
+	iter->x = x;
+	iter->r = r;
+}
+
+/**
+ * Start iterating over the monsters on grids in the player's view
+ */
+void cave_monster_iter_view(struct monster_iter *iter, struct chunk *c,
+							int flag)
+{
+	cave_monster_iter_near(iter, c, player->py, player->px,
+						   z_info->max_sight, flag);
+	iter->view = TRUE;
+}
+
+/**
+ * Get the next monster from an iterator, or NULL when there are no more
+ */
+struct monster *cave_monster_iter_next(struct monster_iter *iter)
+{
+	struct chunk *c = iter->c;
+
+	while (TRUE) {
+		struct monster *mon;
+
+		/* Move on to the next block with monsters in it */
+		while (!iter->m_idx) {
+			if (iter->by > (iter->y2 >> MON_BUCKET_SHIFT))
+				return NULL;
+
+			if (++iter->bx > (iter->x2 >> MON_BUCKET_SHIFT)) {
+				iter->bx = iter->x1 >> MON_BUCKET_SHIFT;
+				if (++iter->by > (iter->y2 >> MON_BUCKET_SHIFT))
+					return NULL;
+			}
+
+			iter->m_idx = c->mon_bucket[iter->by * c->bucket_w + iter->bx];
+		}
+
+		mon = cave_monster(c, iter->m_idx);
+		iter->m_idx = c->mon_next[iter->m_idx];
+
+		/* Blocks overhang the rectangle */
+		if (mon->fy < iter->y1 || mon->fy > iter->y2 ||
+			mon->fx < iter->x1 || mon->fx > iter->x2)
+			continue;
+
+		if (!mon->race)
+			continue;
+		if (iter->flag != RF_NONE && !rf_has(mon->race->flags, iter->flag))
+			continue;
+		if (iter->r >= 0 &&
+			distance(iter->y, iter->x, mon->fy, mon->fx) > iter->r)
+			continue;
+		if (iter->view && !square_isview(c, mon->fy, mon->fx))
+			continue;
+
+		return mon;
+	}
+}
+
+/**
+ * Add a monster to the chunk's list of light sources, if it carries light.
+ *
+ * The list holds monster indices, so moving a monster needs no update, but
+ * placing, deleting or renumbering one does.
+ */
+void cave_light_register(struct chunk *c, int m_idx)
+{
+	struct monster *mon = cave_monster(c, m_idx);
+
+	if (!mon->race || !rf_has(mon->race->flags, RF_HAS_LIGHT))
+		return;
+	if (c->light_slot[m_idx])
+		return;
+
+	c->light_mon[c->light_n++] = m_idx;
+	c->light_slot[m_idx] = c->light_n;
+}
+
+/**
+ * Remove a monster from the chunk's list of light sources, if it is there
+ */
+void cave_light_unregister(struct chunk *c, int m_idx)
+{
+	int slot = c->light_slot[m_idx];
+	int last;
+
+	if (!slot)
+		return;
+
+	/* Move the last entry into the hole */
+	last = c->light_mon[--c->light_n];
+	c->light_mon[slot - 1] = last;
+	c->light_slot[last] = slot;
+	c->light_slot[m_idx] = 0;
+}
+
+/**
+ * Add a monster to the scheduler's list for its energy.  The monster has
+ * not had the current game turn.
+ *
+ * Monster energy must only be changed through cave_monster_set_energy()
+ * once the monster is on the level.
+ */
+void cave_monster_sched_add(struct chunk *c, int m_idx)
+{
+	int energy = cave_monster(c, m_idx)->energy;
+	int head = c->energy_head[energy];
+
+	c->energy_prev[m_idx] = 0;
+	c->energy_next[m_idx] = head;
+	if (head)
+		c->energy_prev[head] = m_idx;
+	c->energy_head[energy] = m_idx;
+
+	c->mon_handled[m_idx] = 0;
+}
+
+/**
+ * Remove a monster from the scheduler
+ */
+void cave_monster_sched_remove(struct chunk *c, int m_idx)
+{
+	int prev = c->energy_prev[m_idx];
+	int next = c->energy_next[m_idx];
+	int energy = cave_monster(c, m_idx)->energy;
+
+	/* Not listed (parked monsters are taken off the lists) */
+	if (!prev && c->energy_head[energy] != m_idx)
+		return;
+
+	if (prev)
+		c->energy_next[prev] = next;
+	else
+		c->energy_head[energy] = next;
+
+	if (next)
+		c->energy_prev[next] = prev;
+
+	c->energy_prev[m_idx] = c->energy_next[m_idx] = 0;
+}
+
+/**
+ * Change a monster's energy, keeping the scheduler up to date
+ */
+void cave_monster_set_energy(struct chunk *c, int m_idx, int energy)
+{
+	struct monster *mon = cave_monster(c, m_idx);
+	u32b handled = c->mon_handled[m_idx];
+
+	if (mon->energy == energy) return;
+
+	/* Parked monsters catch up before anything changes */
+	if (c->dormant_slot[m_idx]) {
+		cave_monster_unpark(c, m_idx);
+		handled = c->mon_handled[m_idx];
+	}
+
+	cave_monster_sched_remove(c, m_idx);
+	mon->energy = energy;
+	cave_monster_sched_add(c, m_idx);
+	c->mon_handled[m_idx] = handled;
+}
+
+/**
+ * Sort monster indices highest first
+ */
+static int cmp_midx_desc(const void *a, const void *b)
+{
+	return *(const s16b *) b - *(const s16b *) a;
+}
+
+/**
+ * List the monsters with at least `minimum_energy` which have not had the
+ * current game turn, highest index first (the order process_monsters() has
+ * always used).  `list` must have room for every monster on the level.
+ * Returns the number listed.
+ */
+int cave_monster_sched_ready(struct chunk *c, int minimum_energy, s16b *list)
+{
+	int energy, n = 0;
+
+	for (energy = MAX(minimum_energy, 0); energy < MON_ENERGY_MAX; energy++) {
+		int m_idx;
+
+		for (m_idx = c->energy_head[energy]; m_idx;
+			 m_idx = c->energy_next[m_idx]) {
+			if (c->mon_handled[m_idx] == c->sched_turn) continue;
+			list[n++] = m_idx;
+		}
+	}
+
+	sort(list, n, sizeof(*list), cmp_midx_desc);
+
+	return n;
+}
+
+/**
+ * Approximate distance from the dormancy anchor, as update_mon() measures it
+ */
+static int dormant_distance(struct chunk *c, const struct monster *mon)
+{
+	int dy = ABS(mon->fy - c->dormant_anchor.y);
+	int dx = ABS(mon->fx - c->dormant_anchor.x);
+
+	return (dy > dx) ? (dy + (dx >> 1)) : (dx + (dy >> 1));
+}
+
+/**
+ * Park a passive monster which has just had its turn, if it is well out of
+ * the player's reach: not hurt, detected or visible, and so far from the
+ * anchor that it can neither notice the player nor come into view before
+ * something wakes it.  Parked monsters take no game turns and are skipped
+ * by update_monsters().  Returns whether the monster was parked.
+ *
+ * While parked, a monster's energy and distance go stale; they are brought
+ * up to date by cave_monster_unpark().
+ */
+bool cave_monster_park(struct chunk *c, int m_idx)
+{
+	struct monster *mon = cave_monster(c, m_idx);
+	int range;
+
+	if (c->dormant_slot[m_idx] || c->dormant_anchor.y < 0)
+		return FALSE;
+	if (mon->hp < mon->maxhp || mon->energy >= z_info->move_energy)
+		return FALSE;
+	if (mflag_has(mon->mflag, MFLAG_MARK) ||
+		mflag_has(mon->mflag, MFLAG_VISIBLE) ||
+		mflag_has(mon->mflag, MFLAG_VIEW))
+		return FALSE;
+
+	range = MAX(mon->race->aaf, z_info->max_sight) + MON_DORMANT_MARGIN;
+	if (dormant_distance(c, mon) <= range)
+		return FALSE;
+
+	cave_monster_sched_remove(c, m_idx);
+	c->dormant_turn[m_idx] = c->sched_turn;
+	c->dormant_mon[c->dormant_n++] = m_idx;
+	c->dormant_slot[m_idx] = c->dormant_n;
+
+	return TRUE;
+}
+
+/**
+ * Take a monster off the dormant list without waking it, for when the
+ * monster is deleted or moved to another index
+ */
+void cave_monster_forget_park(struct chunk *c, int m_idx)
+{
+	int slot = c->dormant_slot[m_idx];
+	int last;
+
+	if (!slot)
+		return;
+
+	/* Move the last entry into the hole */
+	last = c->dormant_mon[--c->dormant_n];
+	c->dormant_mon[slot - 1] = last;
+	c->dormant_slot[last] = slot;
+	c->dormant_slot[m_idx] = 0;
+}
+
+/**
+ * Wake a parked monster, giving it the energy of the game turns it missed
+ * and its true distance from the player.
+ *
+ * A passive monster only ever gains and spends energy, and its speed can't
+ * change while its timed effects are stopped, so the missed turns come to
+ * a multiple of its turn energy modulo move_energy.
+ */
+void cave_monster_unpark(struct chunk *c, int m_idx)
+{
+	struct monster *mon = cave_monster(c, m_idx);
+	u32b parked = c->dormant_turn[m_idx];
+	u32b missed = 0;
+	int mspeed, dy, dx, d;
+
+	if (!c->dormant_slot[m_idx])
+		return;
+	cave_monster_forget_park(c, m_idx);
+
+	/* Turns wholly missed; the current one is still to come */
+	if (c->sched_turn > parked)
+		missed = c->sched_turn - parked - 1;
+	mspeed = mon->mspeed;
+	if (mon->m_timed[MON_TMD_FAST])
+		mspeed += 10;
+	if (mon->m_timed[MON_TMD_SLOW])
+		mspeed -= 10;
+	mon->energy = (mon->energy + (missed % z_info->move_energy) *
+				   turn_energy(mspeed)) % z_info->move_energy;
+	cave_monster_sched_add(c, m_idx);
+
+	/* Parked this game turn, so it has already had it */
+	if (parked == c->sched_turn)
+		c->mon_handled[m_idx] = parked;
+
+	/* Distance from the player, as in update_mon() */
+	dy = ABS(player->py - mon->fy);
+	dx = ABS(player->px - mon->fx);
+	d = (dy > dx) ? (dy + (dx >> 1)) : (dx + (dy >> 1));
+	mon->cdis = MIN(d, 255);
+}
+
+/**
+ * Wake every parked monster
+ */
+void cave_monster_unpark_all(struct chunk *c)
+{
+	while (c->dormant_n)
+		cave_monster_unpark(c, c->dormant_mon[c->dormant_n - 1]);
+}
+
+/**
+ * Note that the player is now at (y, x).  Parked monsters are only safe
+ * while the player stays near the anchor, so once the player strays too far
+ * they are all woken (to be parked again when their turn comes round) and
+ * the anchor moves to the player.
+ */
+void cave_monster_anchor(struct chunk *c, int y, int x)
+{
+	if (c->dormant_n) {
+		if (ABS(y - c->dormant_anchor.y) <= MON_DORMANT_DRIFT &&
+			ABS(x - c->dormant_anchor.x) <= MON_DORMANT_DRIFT)
+			return;
+		cave_monster_unpark_all(c);
+	}
+
+	c->dormant_anchor = loc(x, y);
+}
+
+/**
+ * Rebuild the spatial index, light registry, scheduler and dormant list
+ * from scratch, once the monsters have been moved about the monster list
+ * (see compact_monsters()).  Handled stamps and parked states must already
+ * have moved with their monsters.
+ */
+void cave_monster_reindex(struct chunk *c)
+{
+	int i;
+
+	memset(c->mon_bucket, 0, c->bucket_h * c->bucket_w * sizeof(s16b));
+	memset(c->light_slot, 0, z_info->level_monster_max * sizeof(s16b));
+	memset(c->energy_head, 0, MON_ENERGY_MAX * sizeof(s16b));
+	c->light_n = 0;
+	c->dormant_n = 0;
+
+	for (i = 1; i < cave_monster_max(c); i++) {
+		struct monster *mon = cave_monster(c, i);
+		u32b handled = c->mon_handled[i];
+
+		if (!mon->race) {
+			c->dormant_slot[i] = 0;
+			continue;
+		}
+
+		cave_monster_index_add(c, i);
+		cave_light_register(c, i);
+
+		/* Parked monsters stay off the energy lists */
+		if (c->dormant_slot[i]) {
+			c->energy_prev[i] = c->energy_next[i] = 0;
+			c->dormant_mon[c->dormant_n++] = i;
+			c->dormant_slot[i] = c->dormant_n;
+		} else {
+			cave_monster_sched_add(c, i);
+			c->mon_handled[i] = handled;
+		}
+	}
+}
+
 /**
  * Return the number of doors/traps around (or under) the character.
  */
@@ -132,14 +132,59 @@ typedef struct
 	bool trapborder;
 } grid_data;
 
-struct square {
-	byte feat;
-	bitflag *info;
-	byte cost;
-	byte when;
-	s16b mon;
-	struct object *obj;
-	struct trap *trap;
+/**
+ * Per-square data is held in the chunk as one contiguous plane per field,
+ * each of height * width entries indexed by y * width + x (the info plane
+ * has SQUARE_SIZE bitflags per entry).  These macros give lvalue access to
+ * a single square's entry in each plane.
+ */
+#define square_idx(c, y, x)    ((y) * (c)->width + (x))
+
+#define sq_feat(c, y, x)       ((c)->feat[square_idx(c, y, x)])
+#define sq_info(c, y, x)       ((c)->info + square_idx(c, y, x) * SQUARE_SIZE)
+#define sq_cost(c, y, x)       ((c)->cost[square_idx(c, y, x)])
+#define sq_when(c, y, x)       ((c)->when[square_idx(c, y, x)])
+#define sq_mon(c, y, x)        ((c)->mon[square_idx(c, y, x)])
+#define sq_obj(c, y, x)        ((c)->obj[square_idx(c, y, x)])
+#define sq_trap(c, y, x)       ((c)->trap[square_idx(c, y, x)])
+
+/**
+ * Terrain properties derived from each square's feature, kept by
+ * square_set_feat() as bit planes of one bit per square.  Each row starts on
+ * a fresh u32b, so a row can be scanned 32 squares at a time.  Walls are the
+ * complement of the projectable plane.
+ */
+enum {
+	SQUARE_PLANE_PASSABLE,
+	SQUARE_PLANE_PROJECT,
+	SQUARE_PLANE_BRIGHT,
+	SQUARE_PLANE_NO_FLOW,
+	SQUARE_PLANE_MAX
+};
+
+#define sq_plane_word(c, p, y, x) \
+	((c)->plane[p][(y) * (c)->plane_stride + ((x) >> 5)])
+#define sq_plane_bit(x)              ((u32b) 1 << ((x) & 31))
+#define sq_plane_has(c, p, y, x) \
+	((sq_plane_word(c, p, y, x) & sq_plane_bit(x)) != 0)
+
+/**
+ * Flow fields, holding the walking distance of each grid from the player
+ * under different movement rules.  See cave_flow().
+ */
+enum flow_type {
+	FLOW_DOORS,		/* Through floors and doors, like the scent flow */
+	FLOW_PASSWALL,	/* Through anything except permanent walls */
+	FLOW_FLEE,		/* Derived from FLOW_DOORS; lower is safer from the player */
+	FLOW_MAX
+};
+
+#define FLOW_UNREACHED		MAX_SHORT
+
+struct flow {
+	s16b *dist;		/* Field value for each grid, indexed by square_idx() */
+	u32b stamp;		/* Value of the chunk's terrain_stamp when built */
+	int y, x;		/* Player location when built */
 };
 
 struct chunk {
@@ -158,15 +203,115 @@ struct chunk {
 	u16b feeling_squares; /* How many feeling squares the player has visited */
 	int *feat_count;
 
-	byte **feat;
-	s16b **m_idx;
-
-	struct square **squares;
+	/* Square planes, see sq_feat() and friends */
+	byte *feat;
+	bitflag *info;
+	byte *cost;
+	byte *when;
+	s16b *mon;
+	struct object **obj;
+	struct trap **trap;
+
+	/* Derived terrain bit planes, see sq_plane_has() */
+	u32b *plane[SQUARE_PLANE_MAX];
+	int plane_stride;
+
+	/* Floor squares in no order, for sampling, see square_update_planes() */
+	int *floor_list;
+	int *floor_slot;	/* Index into floor_list plus one, or zero */
+	int floor_n;
+
+	/* Grids with SQUARE_VIEW, and the previous such list, see update_view() */
+	struct loc *view_g;
+	struct loc *view_old;
+	int view_n;
+	int view_old_n;
+	int view_max;
+
+	/* Grids waiting to be redrawn, one bit each, see square_light_spot() */
+	u32b *redraw;
+	struct loc redraw_min;
+	struct loc redraw_max;
+
+	/* Bumped on every terrain change, so cached flow fields can tell */
+	u32b terrain_stamp;
+	struct flow flows[FLOW_MAX];
+
+	/* Scratch space for building flows, see cave_flow() */
+	int *flow_queue;
+	int *flow_seeds;
+	int *flow_count;
+	bool *flow_done;
 
 	struct monster *monsters;
+	struct monster_known_pstate *mon_known;
 	u16b mon_max;
 	u16b mon_cnt;
+	s16b *mon_free;		/* Holes in the monster list, see mon_pop() */
+	int mon_free_n;
 	int mon_current;
+
+	/* Monster spatial index, see cave_monster_index_add() */
+	s16b *mon_bucket;
+	s16b *mon_next;
+	s16b *mon_prev;
+	int bucket_w;
+	int bucket_h;
+
+	/* Light carrying monsters, see cave_light_register() */
+	s16b *light_mon;
+	s16b *light_slot;
+	int light_n;
+
+	/* Monsters by energy, and which have had this game turn, see
+	 * cave_monster_sched_add() */
+	s16b *energy_head;
+	s16b *energy_next;
+	s16b *energy_prev;
+	u32b *mon_handled;
+	u32b sched_turn;
+	s16b *mon_ready;	/* Scratch list for process_monsters() */
+
+	/* Monsters parked out of the player's reach, see cave_monster_park() */
+	s16b *dormant_mon;
+	s16b *dormant_slot;
+	u32b *dormant_turn;
+	int dormant_n;
+	struct loc dormant_anchor;
+};
+
+/**
+ * Monster energy is a byte, so the energy lists cover every value
+ */
+#define MON_ENERGY_MAX	256
+
+/**
+ * Parked monsters are at least this much further from the dormancy anchor
+ * than their detection and sight ranges, and all are woken once the player
+ * strays more than MON_DORMANT_DRIFT grids from the anchor; the approximate
+ * distance moves by at most 3/2 per grid, so neither range is ever reached
+ */
+#define MON_DORMANT_MARGIN	10
+#define MON_DORMANT_DRIFT	5
+
+/**
+ * The monster spatial index keeps a list of the monsters in each
+ * MON_BUCKET_SIZE x MON_BUCKET_SIZE block of the level.
+ */
+#define MON_BUCKET_SHIFT	3
+#define MON_BUCKET_SIZE		(1 << MON_BUCKET_SHIFT)
+
+/**
+ * Iterator over the monsters in part of a level, see cave_monster_iter_rect()
+ */
+struct monster_iter {
+	struct chunk *c;
+	int y1, x1, y2, x2;	/* Bounding rectangle */
+	int y, x, r;		/* Centre and radius, r < 0 for none */
+	int flag;			/* Race flag needed, or RF_NONE */
+	bool view;			/* Only monsters on SQUARE_VIEW grids */
+	int by, bx;			/* Current block */
+	int m_idx;			/* Next monster in the current block */
 };
 
 /*** Feature Indexes (see "lib/edit/terrain.txt") ***/
@@ -215,6 +360,8 @@ u16b chunk_list_max;
 /* cave-view.c */
 int distance(int y1, int x1, int y2, int x2);
 bool los(struct chunk *c, int y1, int x1, int y2, int x2);
+void los_many(struct chunk *c, struct loc from, const struct loc *targets,
+			  int n, bool *out);
 void forget_view(struct chunk *c);
 void update_view(struct chunk *c, struct player *p);
 bool no_light(void);
@@ -223,12 +370,16 @@ bool no_light(void);
 void map_info(unsigned x, unsigned y, grid_data *g);
 void square_note_spot(struct chunk *c, int y, int x);
 void square_light_spot(struct chunk *c, int y, int x);
+void cave_flush_redraw(struct chunk *c);
 void light_room(int y1, int x1, bool light);
 void wiz_light(struct chunk *c, bool full);
 void wiz_dark(void);
 void cave_illuminate(struct chunk *c, bool daytime);
 void cave_update_flow(struct chunk *c);
 void cave_forget_flow(struct chunk *c);
+s16b *cave_flow(struct chunk *c, enum flow_type type);
+bool cave_flow_downhill(struct chunk *c, enum flow_type type, int y, int x,
+						int *ny, int *nx);
 
 /* cave-square.c */
 /**
@@ -323,6 +474,7 @@ void square_excise_object(struct chunk *c, int y, int x, struct object *obj);
 void square_excise_pile(struct chunk *c, int y, int x);
 
 void square_set_feat(struct chunk *c, int y, int x, int feat);
+void square_update_planes(struct chunk *c, int y, int x);
 
 /* Feature placers */
 void square_add_trap(struct chunk *c, int y, int x);
@@ -360,8 +512,30 @@ void cave_free(struct chunk *c);
 void scatter(struct chunk *c, int *yp, int *xp, int y, int x, int d, bool need_los);
 
 struct monster *cave_monster(struct chunk *c, int idx);
+struct monster_known_pstate *cave_monster_known(struct chunk *c, int idx);
 int cave_monster_max(struct chunk *c);
 int cave_monster_count(struct chunk *c);
+void cave_monster_index_add(struct chunk *c, int m_idx);
+void cave_monster_index_remove(struct chunk *c, int m_idx);
+void cave_monster_iter_rect(struct monster_iter *iter, struct chunk *c,
+							int y1, int x1, int y2, int x2, int flag);
+void cave_monster_iter_near(struct monster_iter *iter, struct chunk *c,
+							int y, int x, int r, int flag);
+void cave_monster_iter_view(struct monster_iter *iter, struct chunk *c,
+							int flag);
+struct monster *cave_monster_iter_next(struct monster_iter *iter);
+void cave_light_register(struct chunk *c, int m_idx);
+void cave_light_unregister(struct chunk *c, int m_idx);
+void cave_monster_sched_add(struct chunk *c, int m_idx);
+void cave_monster_sched_remove(struct chunk *c, int m_idx);
+void cave_monster_set_energy(struct chunk *c, int m_idx, int energy);
+int cave_monster_sched_ready(struct chunk *c, int minimum_energy, s16b *list);
+bool cave_monster_park(struct chunk *c, int m_idx);
+void cave_monster_unpark(struct chunk *c, int m_idx);
+void cave_monster_unpark_all(struct chunk *c);
+void cave_monster_forget_park(struct chunk *c, int m_idx);
+void cave_monster_anchor(struct chunk *c, int y, int x);
+void cave_monster_reindex(struct chunk *c);
 
 int count_feats(int *y, int *x, bool (*test)(struct chunk *cave, int y, int x), bool under);
 
@@ -527,7 +527,7 @@ void do_cmd_close(struct command *cmd)
 	}
 
 	/* Monster - alert, then attack */
-	if (cave->squares[y][x].mon > 0) {
+	if (sq_mon(cave, y, x) > 0) {
 		msg("There is a monster in the way!");
 		py_attack(y, x);
 	} else
@@ -587,7 +587,7 @@ static bool twall(int y, int x)
 	sound(MSG_DIG);
 
 	/* Forget the wall */
-	sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+	sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 	/* Remove the feature */
 	square_tunnel_wall(cave, y, x);
@@ -706,7 +706,7 @@ void do_cmd_tunnel(struct command *cmd)
 	}
 
 	/* Attack any monster we run into */
-	if (cave->squares[y][x].mon > 0) {
+	if (sq_mon(cave, y, x) > 0) {
 		msg("There is a monster in the way!");
 		py_attack(y, x);
 	} else {
@@ -810,7 +810,7 @@ static bool do_cmd_lock_door(int y, int x)
 static bool do_cmd_disarm_aux(int y, int x)
 {
 	int i, j, power;
-    struct trap *trap = cave->squares[y][x].trap;
+    struct trap *trap = sq_trap(cave, y, x);
 	bool more = FALSE;
 
 
@@ -854,7 +854,7 @@ static bool do_cmd_disarm_aux(int y, int x)
 		player_exp_gain(player, power);
 
 		/* Forget the trap */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 		/* Remove the trap */
 		square_destroy_trap(cave, y, x);
@@ -934,7 +934,7 @@ void do_cmd_disarm(struct command *cmd)
 
 
 	/* Monster */
-	if (cave->squares[y][x].mon > 0) {
+	if (sq_mon(cave, y, x) > 0) {
 		msg("There is a monster in the way!");
 		py_attack(y, x);
 	} else if (obj)
@@ -983,7 +983,7 @@ void do_cmd_alter_aux(int dir)
 	}
 
 	/* Action depends on what's there */
-	if (cave->squares[y][x].mon > 0)
+	if (sq_mon(cave, y, x) > 0)
 		/* Attack monsters */
 		py_attack(y, x);
 	else if (square_isdiggable(cave, y, x))
@@ -1030,7 +1030,7 @@ void move_player(int dir, bool disarm)
 	int y = py + ddy[dir];
 	int x = px + ddx[dir];
 
-	int m_idx = cave->squares[y][x].mon;
+	int m_idx = sq_mon(cave, y, x);
 	struct monster *m_ptr = cave_monster(cave, m_idx);
 	bool alterable = (square_isknowntrap(cave, y, x) ||
 					  square_iscloseddoor(cave, y, x));
@@ -1065,15 +1065,15 @@ void move_player(int dir, bool disarm)
 			if (square_isrubble(cave, y, x)) {
 				msgt(MSG_HITWALL,
 					 "You feel a pile of rubble blocking your way.");
-				sqinfo_on(cave->squares[y][x].info, SQUARE_MARK);
+				sqinfo_on(sq_info(cave, y, x), SQUARE_MARK);
 				square_light_spot(cave, y, x);
 			} else if (square_iscloseddoor(cave, y, x)) {
 				msgt(MSG_HITWALL, "You feel a door blocking your way.");
-				sqinfo_on(cave->squares[y][x].info, SQUARE_MARK);
+				sqinfo_on(sq_info(cave, y, x), SQUARE_MARK);
 				square_light_spot(cave, y, x);
 			} else {
 				msgt(MSG_HITWALL, "You feel a wall blocking your way.");
-				sqinfo_on(cave->squares[y][x].info, SQUARE_MARK);
+				sqinfo_on(sq_info(cave, y, x), SQUARE_MARK);
 				square_light_spot(cave, y, x);
 			}
 		} else {
@@ -1154,7 +1154,7 @@ void move_player(int dir, bool disarm)
  */
 static bool do_cmd_walk_test(int y, int x)
 {
-	int m_idx = cave->squares[y][x].mon;
+	int m_idx = sq_mon(cave, y, x);
 	struct monster *m_ptr = cave_monster(cave, m_idx);
 
 	/* Allow attack on visible monsters if unafraid */
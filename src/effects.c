@@ -897,7 +897,7 @@ bool effect_handler_MAP_AREA(effect_handler_context_t *context)
 
 				/* Memorize normal features */
 				if (!square_isfloor(cave, y, x)) {
-					sqinfo_on(cave->squares[y][x].info, SQUARE_MARK);
+					sqinfo_on(sq_info(cave, y, x), SQUARE_MARK);
 					square_light_spot(cave, y, x);
 				}
 
@@ -908,8 +908,9 @@ bool effect_handler_MAP_AREA(effect_handler_context_t *context)
 
 					/* Memorize walls (etc) */
 					if (square_seemslikewall(cave, yy, xx)) {
-						sqinfo_on(cave->squares[yy][xx].info, SQUARE_MARK);
-						cave_k->squares[yy][xx].feat = cave->squares[yy][xx].feat;
+						sqinfo_on(sq_info(cave, yy, xx), SQUARE_MARK);
+						sq_feat(cave_k, yy, xx) = sq_feat(cave, yy, xx);
+						square_update_planes(cave_k, yy, xx);
 						square_light_spot(cave, yy, xx);
 					}
 				}
@@ -979,7 +980,7 @@ bool effect_handler_DETECT_TRAPS(effect_handler_context_t *context)
 			}
 
 			/* Mark as trap-detected */
-			sqinfo_on(cave->squares[y][x].info, SQUARE_DTRAP);
+			sqinfo_on(sq_info(cave, y, x), SQUARE_DTRAP);
 		}
 	}
 
@@ -990,9 +991,9 @@ bool effect_handler_DETECT_TRAPS(effect_handler_context_t *context)
 
 			/* See if this grid is on the edge */
 			if (square_dtrap_edge(cave, y, x)) {
-				sqinfo_on(cave->squares[y][x].info, SQUARE_DEDGE);
+				sqinfo_on(sq_info(cave, y, x), SQUARE_DEDGE);
 			} else {
-				sqinfo_off(cave->squares[y][x].info, SQUARE_DEDGE);
+				sqinfo_off(sq_info(cave, y, x), SQUARE_DEDGE);
 			}
 
 			/* Redraw */
@@ -1053,8 +1054,9 @@ bool effect_handler_DETECT_DOORS(effect_handler_context_t *context)
 			/* Detect doors */
 			if (square_isdoor(cave, y, x)) {
 				/* Hack -- Memorize */
-				sqinfo_on(cave->squares[y][x].info, SQUARE_MARK);
-				cave_k->squares[y][x].feat = cave->squares[y][x].feat;
+				sqinfo_on(sq_info(cave, y, x), SQUARE_MARK);
+				sq_feat(cave_k, y, x) = sq_feat(cave, y, x);
+				square_update_planes(cave_k, y, x);
 				/* Redraw */
 				square_light_spot(cave, y, x);
 
@@ -1106,8 +1108,9 @@ bool effect_handler_DETECT_STAIRS(effect_handler_context_t *context)
 			/* Detect stairs */
 			if (square_isstairs(cave, y, x)) {
 				/* Hack -- Memorize */
-				sqinfo_on(cave->squares[y][x].info, SQUARE_MARK);
-				cave_k->squares[y][x].feat = cave->squares[y][x].feat;
+				sqinfo_on(sq_info(cave, y, x), SQUARE_MARK);
+				sq_feat(cave_k, y, x) = sq_feat(cave, y, x);
+				square_update_planes(cave_k, y, x);
 				/* Redraw */
 				square_light_spot(cave, y, x);
 
@@ -1161,7 +1164,7 @@ bool effect_handler_DETECT_GOLD(effect_handler_context_t *context)
 			/* Magma/Quartz + Known Gold */
 			if (square_hasgoldvein(cave, y, x)) {
 				/* Hack -- Memorize */
-				sqinfo_on(cave->squares[y][x].info, SQUARE_MARK);
+				sqinfo_on(sq_info(cave, y, x), SQUARE_MARK);
 
 				/* Redraw */
 				square_light_spot(cave, y, x);
@@ -1306,8 +1309,9 @@ bool effect_handler_DETECT_OBJECTS(effect_handler_context_t *context)
  */
 bool effect_handler_DETECT_VISIBLE_MONSTERS(effect_handler_context_t *context)
 {
-	int i, x, y;
 	int x1, x2, y1, y2;
+	struct monster_iter iter;
+	monster_type *m_ptr;
 	int y_dist = context->value.dice;
 	int x_dist = context->value.sides;
 
@@ -1324,24 +1328,14 @@ bool effect_handler_DETECT_VISIBLE_MONSTERS(effect_handler_context_t *context)
 	if (y2 > cave->height - 1) y2 = cave->height - 1;
 	if (x2 > cave->width - 1) x2 = cave->width - 1;
 
-	/* Scan monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		monster_type *m_ptr = cave_monster(cave, i);
-
-		/* Skip dead monsters */
-		if (!m_ptr->race) continue;
-
-		/* Location */
-		y = m_ptr->fy;
-		x = m_ptr->fx;
-
-		/* Only detect nearby monsters */
-		if (x < x1 || y < y1 || x > x2 || y > y2) continue;
-
+	/* Scan nearby monsters */
+	cave_monster_iter_rect(&iter, cave, y1, x1, y2, x2, RF_NONE);
+	while ((m_ptr = cave_monster_iter_next(&iter))) {
 		/* Detect all non-invisible, obvious monsters */
 		if (!rf_has(m_ptr->race->flags, RF_INVISIBLE) &&
 			!mflag_has(m_ptr->mflag, MFLAG_UNAWARE)) {
 			/* Hack -- Detect the monster */
+			cave_monster_unpark(cave, m_ptr->midx);
 			mflag_on(m_ptr->mflag, MFLAG_MARK);
 			mflag_on(m_ptr->mflag, MFLAG_SHOW);
 
@@ -1375,8 +1369,9 @@ bool effect_handler_DETECT_VISIBLE_MONSTERS(effect_handler_context_t *context)
  */
 bool effect_handler_DETECT_INVISIBLE_MONSTERS(effect_handler_context_t *context)
 {
-	int i, x, y;
 	int x1, x2, y1, y2;
+	struct monster_iter iter;
+	monster_type *m_ptr;
 	int y_dist = context->value.dice;
 	int x_dist = context->value.sides;
 
@@ -1393,43 +1388,29 @@ bool effect_handler_DETECT_INVISIBLE_MONSTERS(effect_handler_context_t *context)
 	if (y2 > cave->height - 1) y2 = cave->height - 1;
 	if (x2 > cave->width - 1) x2 = cave->width - 1;
 
-	/* Scan monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		monster_type *m_ptr = cave_monster(cave, i);
-		monster_lore *l_ptr;
+	/* Scan nearby invisible monsters */
+	cave_monster_iter_rect(&iter, cave, y1, x1, y2, x2, RF_INVISIBLE);
+	while ((m_ptr = cave_monster_iter_next(&iter))) {
+		monster_lore *l_ptr = get_lore(m_ptr->race);
 
-		/* Skip dead monsters */
-		if (!m_ptr->race) continue;
-
-		l_ptr = get_lore(m_ptr->race);
-
-		/* Location */
-		y = m_ptr->fy;
-		x = m_ptr->fx;
+		/* Take note that they are invisible */
+		rf_on(l_ptr->flags, RF_INVISIBLE);
 
-		/* Only detect nearby monsters */
-		if (x < x1 || y < y1 || x > x2 || y > y2) continue;
+		/* Update monster recall window */
+		if (player->upkeep->monster_race == m_ptr->race)
+			player->upkeep->redraw |= (PR_MONSTER);
 
-		/* Detect invisible monsters */
-		if (rf_has(m_ptr->race->flags, RF_INVISIBLE)) {
-			/* Take note that they are invisible */
-			rf_on(l_ptr->flags, RF_INVISIBLE);
-
-			/* Update monster recall window */
-			if (player->upkeep->monster_race == m_ptr->race)
-				player->upkeep->redraw |= (PR_MONSTER);
+		/* Detect the monster */
+		cave_monster_unpark(cave, m_ptr->midx);
+		mflag_on(m_ptr->mflag, MFLAG_MARK);
+		mflag_on(m_ptr->mflag, MFLAG_SHOW);
 
-			/* Detect the monster */
-			mflag_on(m_ptr->mflag, MFLAG_MARK);
-			mflag_on(m_ptr->mflag, MFLAG_SHOW);
+		/* Update the monster */
+		update_mon(m_ptr, cave, FALSE);
 
-			/* Update the monster */
-			update_mon(m_ptr, cave, FALSE);
-
-			/* Detect */
-			monsters = TRUE;
-			context->ident = TRUE;
-		}
+		/* Detect */
+		monsters = TRUE;
+		context->ident = TRUE;
 	}
 
 	if (monsters)
@@ -1449,8 +1430,9 @@ bool effect_handler_DETECT_INVISIBLE_MONSTERS(effect_handler_context_t *context)
  */
 bool effect_handler_DETECT_EVIL(effect_handler_context_t *context)
 {
-	int i, x, y;
 	int x1, x2, y1, y2;
+	struct monster_iter iter;
+	monster_type *m_ptr;
 	int y_dist = context->value.dice;
 	int x_dist = context->value.sides;
 
@@ -1467,43 +1449,29 @@ bool effect_handler_DETECT_EVIL(effect_handler_context_t *context)
 	if (y2 > cave->height - 1) y2 = cave->height - 1;
 	if (x2 > cave->width - 1) x2 = cave->width - 1;
 
-	/* Scan monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		monster_type *m_ptr = cave_monster(cave, i);
-		monster_lore *l_ptr;
-
-		/* Skip dead monsters */
-		if (!m_ptr->race) continue;
-
-		l_ptr = get_lore(m_ptr->race);
-
-		/* Location */
-		y = m_ptr->fy;
-		x = m_ptr->fx;
-
-		/* Only detect nearby monsters */
-		if (x < x1 || y < y1 || x > x2 || y > y2) continue;
+	/* Scan nearby evil monsters */
+	cave_monster_iter_rect(&iter, cave, y1, x1, y2, x2, RF_EVIL);
+	while ((m_ptr = cave_monster_iter_next(&iter))) {
+		monster_lore *l_ptr = get_lore(m_ptr->race);
 
-		/* Detect evil monsters */
-		if (rf_has(m_ptr->race->flags, RF_EVIL)) {
-			/* Take note that they are evil */
-			rf_on(l_ptr->flags, RF_EVIL);
+		/* Take note that they are evil */
+		rf_on(l_ptr->flags, RF_EVIL);
 
-			/* Update monster recall window */
-			if (player->upkeep->monster_race == m_ptr->race)
-				player->upkeep->redraw |= (PR_MONSTER);
+		/* Update monster recall window */
+		if (player->upkeep->monster_race == m_ptr->race)
+			player->upkeep->redraw |= (PR_MONSTER);
 
-			/* Detect the monster */
-			mflag_on(m_ptr->mflag, MFLAG_MARK);
-			mflag_on(m_ptr->mflag, MFLAG_SHOW);
+		/* Detect the monster */
+		cave_monster_unpark(cave, m_ptr->midx);
+		mflag_on(m_ptr->mflag, MFLAG_MARK);
+		mflag_on(m_ptr->mflag, MFLAG_SHOW);
 
-			/* Update the monster */
-			update_mon(m_ptr, cave, FALSE);
+		/* Update the monster */
+		update_mon(m_ptr, cave, FALSE);
 
-			/* Detect */
-			monsters = TRUE;
-			context->ident = TRUE;
-		}
+		/* Detect */
+		monsters = TRUE;
+		context->ident = TRUE;
 	}
 
 	if (monsters)
@@ -2071,32 +2039,38 @@ bool effect_handler_RECHARGE(effect_handler_context_t *context)
  */
 bool effect_handler_PROJECT_LOS(effect_handler_context_t *context)
 {
-	int i, x, y;
+	int i, n = 0;
 	int dam = effect_calculate_value(context, context->p2 ? TRUE : FALSE);
 	int typ = context->p1;
 
 	int flg = PROJECT_JUMP | PROJECT_KILL | PROJECT_HIDE;
 
+	struct monster_iter iter;
+	monster_type *m_ptr;
+	s16b *targets;
+
 	if (context->aware) flg |= PROJECT_AWARE;
 
+	/* Find the monsters in line of sight first, as projecting may move them */
+	targets = mem_zalloc(cave_monster_max(cave) * sizeof(s16b));
+	cave_monster_iter_view(&iter, cave, RF_NONE);
+	while ((m_ptr = cave_monster_iter_next(&iter)))
+		targets[n++] = m_ptr->midx;
+
 	/* Affect all (nearby) monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		monster_type *m_ptr = cave_monster(cave, i);
+	for (i = 0; i < n; i++) {
+		m_ptr = cave_monster(cave, targets[i]);
 
 		/* Paranoia -- Skip dead monsters */
 		if (!m_ptr->race) continue;
 
-		/* Location */
-		y = m_ptr->fy;
-		x = m_ptr->fx;
-
-		/* Require line of sight */
-		if (!square_isview(cave, y, x)) continue;
-
 		/* Jump directly to the target monster */
-		if (project(-1, 0, y, x, dam, typ, flg, 0, 0)) context->ident = TRUE;
+		if (project(-1, 0, m_ptr->fy, m_ptr->fx, dam, typ, flg, 0, 0))
+			context->ident = TRUE;
 	}
 
+	mem_free(targets);
+
 	/* Result */
 	return TRUE;
 }
@@ -2117,10 +2091,11 @@ bool effect_handler_ACQUIRE(effect_handler_context_t *context)
  */
 bool effect_handler_AGGRAVATE(effect_handler_context_t *context)
 {
-	int i;
 	bool sleep = FALSE;
 	int midx = cave->mon_current;
 	monster_type *who = midx > 0 ? cave_monster(cave, midx) : NULL;
+	struct monster_iter iter;
+	monster_type *m_ptr;
 
 	/* Immediately obvious if the player did it */
 	if (!who) {
@@ -2129,16 +2104,14 @@ bool effect_handler_AGGRAVATE(effect_handler_context_t *context)
 	}
 
 	/* Aggravate everyone nearby */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		monster_type *m_ptr = cave_monster(cave, i);
-
-		/* Paranoia -- Skip dead monsters */
-		if (!m_ptr->race) continue;
-
+	cave_monster_iter_near(&iter, cave, player->py, player->px,
+						   z_info->max_sight * 2, RF_NONE);
+	while ((m_ptr = cave_monster_iter_next(&iter))) {
 		/* Skip aggravating monster (or player) */
 		if (m_ptr == who) continue;
 
 		/* Wake up nearby sleeping monsters */
+		cave_monster_unpark(cave, m_ptr->midx);
 		if ((m_ptr->cdis < z_info->max_sight * 2) &&
 			m_ptr->m_timed[MON_TMD_SLEEP]) {
 			mon_clear_timed(m_ptr, MON_TMD_SLEEP, MON_TMD_FLG_NOMESSAGE, FALSE);
@@ -2302,27 +2275,22 @@ bool effect_handler_BANISH(effect_handler_context_t *context)
  */
 bool effect_handler_MASS_BANISH(effect_handler_context_t *context)
 {
-	int i;
 	int radius = context->p2 ? context->p2 : z_info->max_sight;
 	unsigned dam = 0;
+	struct monster_iter iter;
+	monster_type *m_ptr;
 
 	context->ident = TRUE;
 
 	/* Delete the (nearby) monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		monster_type *m_ptr = cave_monster(cave, i);
-
-		/* Paranoia -- Skip dead monsters */
-		if (!m_ptr->race) continue;
-
+	cave_monster_iter_near(&iter, cave, player->py, player->px, radius,
+						   RF_NONE);
+	while ((m_ptr = cave_monster_iter_next(&iter))) {
 		/* Hack -- Skip unique monsters */
 		if (rf_has(m_ptr->race->flags, RF_UNIQUE)) continue;
 
-		/* Skip distant monsters */
-		if (m_ptr->cdis > radius) continue;
-
 		/* Delete the monster */
-		delete_monster_idx(i);
+		delete_monster_idx(m_ptr->midx);
 
 		/* Take some damage */
 		dam += randint1(3);
@@ -2342,20 +2310,13 @@ bool effect_handler_MASS_BANISH(effect_handler_context_t *context)
  */
 bool effect_handler_PROBE(effect_handler_context_t *context)
 {
-	int i;
-
 	bool probe = FALSE;
+	struct monster_iter iter;
+	monster_type *m_ptr;
 
-	/* Probe all (nearby) monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		monster_type *m_ptr = cave_monster(cave, i);
-
-		/* Paranoia -- Skip dead monsters */
-		if (!m_ptr->race) continue;
-
-		/* Require line of sight */
-		if (!square_isview(cave, m_ptr->fy, m_ptr->fx)) continue;
-
+	/* Probe all monsters in line of sight */
+	cave_monster_iter_view(&iter, cave, RF_NONE);
+	while ((m_ptr = cave_monster_iter_next(&iter))) {
 		/* Probe visible monsters */
 		if (mflag_has(m_ptr->mflag, MFLAG_VISIBLE)) {
 			char m_name[80];
@@ -2480,13 +2441,13 @@ bool effect_handler_THRUST_AWAY(effect_handler_context_t *context)
 			xx = x + ddx_ddd[d % 8];
 
 			/* Cannot switch places with stronger monsters. */
-			if (cave->squares[yy][xx].mon != 0) {
+			if (sq_mon(cave, yy, xx) != 0) {
 				/* A monster is trying to pass. */
-				if (cave->squares[y][x].mon > 0) {
+				if (sq_mon(cave, y, x) > 0) {
 
 					monster_type *m_ptr = square_monster(cave, y, x);
 
-					if (cave->squares[yy][xx].mon > 0) {
+					if (sq_mon(cave, yy, xx) > 0) {
 						monster_type *n_ptr = square_monster(cave, yy, xx);
 
 						/* Monsters cannot pass by stronger monsters. */
@@ -2500,8 +2461,8 @@ bool effect_handler_THRUST_AWAY(effect_handler_context_t *context)
 				}
 
 				/* The player is trying to pass. */
-				if (cave->squares[y][x].mon < 0) {
-					if (cave->squares[yy][xx].mon > 0) {
+				if (sq_mon(cave, y, x) < 0) {
+					if (sq_mon(cave, yy, xx) > 0) {
 						monster_type *n_ptr = square_monster(cave, yy, xx);
 
 						/* Players cannot pass by stronger monsters. */
@@ -2532,7 +2493,7 @@ bool effect_handler_THRUST_AWAY(effect_handler_context_t *context)
 				/* If there are walls everywhere, stop here. */
 				else if (d == (8 + first_d - 1)) {
 					/* Message for player. */
-					if (cave->squares[y][x].mon < 0)
+					if (sq_mon(cave, y, x) < 0)
 						msg("You come to rest next to a wall.");
 					i = grids_away;
 				}
@@ -2551,7 +2512,7 @@ bool effect_handler_THRUST_AWAY(effect_handler_context_t *context)
 	}
 
 	/* Clear the projection mark. */
-	sqinfo_off(cave->squares[y][x].info, SQUARE_PROJECT);
+	sqinfo_off(sq_info(cave, y, x), SQUARE_PROJECT);
 
 	return TRUE;
 }
@@ -2652,7 +2613,7 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 	monster_swap(y_start, x_start, y, x);
 
 	/* Clear any projection marker to prevent double processing */
-	sqinfo_off(cave->squares[y][x].info, SQUARE_PROJECT);
+	sqinfo_off(sq_info(cave, y, x), SQUARE_PROJECT);
 
 	/* Lots of updates after monster_swap */
 	handle_stuff(player);
@@ -2723,7 +2684,7 @@ bool effect_handler_TELEPORT_TO(effect_handler_context_t *context)
 	monster_swap(py, px, y, x);
 
 	/* Clear any projection marker to prevent double processing */
-	sqinfo_off(cave->squares[y][x].info, SQUARE_PROJECT);
+	sqinfo_off(sq_info(cave, y, x), SQUARE_PROJECT);
 
 	/* Lots of updates after monster_swap */
 	handle_stuff(player);
@@ -2817,11 +2778,11 @@ bool effect_handler_DESTRUCTION(effect_handler_context_t *context)
 			if (k > r) continue;
 
 			/* Lose room and vault */
-			sqinfo_off(cave->squares[y][x].info, SQUARE_ROOM);
-			sqinfo_off(cave->squares[y][x].info, SQUARE_VAULT);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_ROOM);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_VAULT);
 
 			/* Lose light */
-			sqinfo_off(cave->squares[y][x].info, SQUARE_GLOW);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_GLOW);
 			square_light_spot(cave, y, x);
 
 			/* Deal with player later */
@@ -2834,7 +2795,7 @@ bool effect_handler_DESTRUCTION(effect_handler_context_t *context)
 			if (square_isstairs(cave, y, x)) continue;
 
 			/* Lose knowledge (keeping knowledge of stairs) */
-			sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 			/* Destroy any grid that isn't a permament wall */
 			if (!square_isperm(cave, y, x)) {
@@ -2943,12 +2904,12 @@ bool effect_handler_EARTHQUAKE(effect_handler_context_t *context)
 			if (distance(cy, cx, yy, xx) > r) continue;
 
 			/* Lose room and vault */
-			sqinfo_off(cave->squares[yy][xx].info, SQUARE_ROOM);
-			sqinfo_off(cave->squares[yy][xx].info, SQUARE_VAULT);
+			sqinfo_off(sq_info(cave, yy, xx), SQUARE_ROOM);
+			sqinfo_off(sq_info(cave, yy, xx), SQUARE_VAULT);
 
 			/* Lose light and knowledge */
-			sqinfo_off(cave->squares[yy][xx].info, SQUARE_GLOW);
-			sqinfo_off(cave->squares[yy][xx].info, SQUARE_MARK);
+			sqinfo_off(sq_info(cave, yy, xx), SQUARE_GLOW);
+			sqinfo_off(sq_info(cave, yy, xx), SQUARE_MARK);
 
 			/* Skip the epicenter */
 			if (!dx && !dy) continue;
@@ -3053,7 +3014,7 @@ bool effect_handler_EARTHQUAKE(effect_handler_context_t *context)
 			if (!map[16 + yy - cy][16 + xx - cx]) continue;
 
 			/* Process monsters */
-			if (cave->squares[yy][xx].mon > 0) {
+			if (sq_mon(cave, yy, xx) > 0) {
 				monster_type *m_ptr = square_monster(cave, yy, xx);
 
 				/* Most monsters cannot co-exist with rock */
@@ -3111,6 +3072,7 @@ bool effect_handler_EARTHQUAKE(effect_handler_context_t *context)
 						msg("%s is embedded in the rock!", m_name);
 
 					/* Apply damage directly */
+					cave_monster_unpark(cave, m_ptr->midx);
 					m_ptr->hp -= damage;
 
 					/* Delete (not kill) "dead" monsters */
@@ -4079,7 +4041,7 @@ bool effect_handler_TRAP_RUNE_SUMMON(effect_handler_context_t *context)
 	msgt(MSG_SUM_MONSTER, "You are enveloped in a cloud of smoke!");
 
 	/* Remove trap */
-	sqinfo_off(cave->squares[player->py][player->px].info, SQUARE_MARK);
+	sqinfo_off(sq_info(cave, player->py, player->px), SQUARE_MARK);
 	square_destroy_trap(cave, player->py, player->px);
 
 	for (i = 0; i < num; i++)
@@ -161,6 +161,24 @@ void event_signal_point(game_event_type type, int x, int y)
 }
 
 
+/**
+ * Signal a rectangle of grids from min to max.  If grids is not NULL only
+ * those grids with their bit set in it (stride words to a row, indexed from
+ * the top left of the level) are meant; a min of (-1, -1) means everything.
+ */
+void event_signal_region(game_event_type type, struct loc min, struct loc max,
+						 const u32b *grids, int stride)
+{
+	game_event_data data;
+	data.region.min = min;
+	data.region.max = max;
+	data.region.grids = grids;
+	data.region.stride = stride;
+
+	game_event_dispatch(type, &data);
+}
+
+
 void event_signal_string(game_event_type type, const char *s)
 {
 	game_event_data data;
@@ -26,7 +26,8 @@
  */
 typedef enum game_event_type
 {
-	EVENT_MAP = 0,		/* Some part of the map has changed. */
+	EVENT_MAP = 0,		/* Some part of the map has changed, see
+				   event_signal_region(). */
 
 	EVENT_STATS,  		/* One or more of the stats. */
 	EVENT_HP,	   	/* HP or MaxHP. */
@@ -99,6 +100,14 @@ typedef union
 {
 	struct loc point;
 
+	struct
+	{
+		struct loc min;
+		struct loc max;
+		const u32b *grids;
+		int stride;
+	} region;
+
 	const char *string;
 
 	bool flag;
@@ -175,6 +184,8 @@ void event_remove_handler_set(game_event_type *type, size_t n_types, game_event_
 void event_signal_birthpoints(int stats[6], int remaining);
 
 void event_signal_point(game_event_type, int x, int y);
+void event_signal_region(game_event_type type, struct loc min, struct loc max,
+						 const u32b *grids, int stride);
 void event_signal_string(game_event_type, const char *s);
 void event_signal_message(game_event_type type, int t, const char *s);
 void event_signal_flag(game_event_type type, bool flag);
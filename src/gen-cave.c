@@ -83,8 +83,8 @@
  */
 static bool square_is_granite_with_flag(struct chunk *c, int y, int x, int flag)
 {
-	if (c->squares[y][x].feat != FEAT_GRANITE) return FALSE;
-	if (!sqinfo_has(c->squares[y][x].info, flag)) return FALSE;
+	if (sq_feat(c, y, x) != FEAT_GRANITE) return FALSE;
+	if (!sqinfo_has(sq_info(c, y, x), flag)) return FALSE;
 
 	return TRUE;
 }
@@ -273,7 +273,7 @@ static void build_tunnel(struct chunk *c, int row1, int col1, int row2, int col2
 			row1 = tmp_row;
 			col1 = tmp_col;
 
-		} else if (tf_has(f_info[c->squares[tmp_row][tmp_col].feat].flags, TF_GRANITE)|| tf_has(f_info[c->squares[tmp_row][tmp_col].feat].flags, TF_PERMANENT)){
+		} else if (tf_has(f_info[sq_feat(c, tmp_row, tmp_col)].flags, TF_GRANITE)|| tf_has(f_info[sq_feat(c, tmp_row, tmp_col)].flags, TF_PERMANENT)){
 			/* Tunnel through all other walls */
 			/* Accept this location */
 			row1 = tmp_row;
@@ -466,6 +466,8 @@ struct chunk *classic_gen(struct player *p) {
 	dun->room_map = mem_zalloc(dun->row_blocks * sizeof(bool*));
 	for (i = 0; i < dun->row_blocks; i++)
 		dun->room_map[i] = mem_zalloc(dun->col_blocks * sizeof(bool));
+	dun->room_sums = mem_zalloc((dun->row_blocks + 1) *
+								(dun->col_blocks + 1) * sizeof(int));
 
     /* Initialize the block table */
     blocks_tried = mem_zalloc(dun->row_blocks * sizeof(bool*));
@@ -544,6 +546,7 @@ struct chunk *classic_gen(struct player *p) {
 	}
 	mem_free(blocks_tried);
 	mem_free(dun->room_map);
+	mem_free(dun->room_sums);
 
     /* Generate permanent walls around the edge of the generated area */
     draw_rectangle(c, 0, 0, c->height - 1, c->width - 1, 
@@ -744,7 +747,7 @@ struct chunk *labyrinth_chunk(int depth, int h, int w, bool lit, bool soft)
 			int k = yx_to_i(y, x, w);
 			sets[k] = k;
 			square_set_feat(c, y + 1, x + 1, FEAT_FLOOR);
-			if (lit) sqinfo_on(c->squares[y + 1][x + 1].info, SQUARE_GLOW);
+			if (lit) sqinfo_on(sq_info(c, y + 1, x + 1), SQUARE_GLOW);
 		}
     }
 
@@ -773,7 +776,7 @@ struct chunk *labyrinth_chunk(int depth, int h, int w, bool lit, bool soft)
 			int sa = sets[a];
 			int sb = sets[b];
 			square_set_feat(c, y + 1, x + 1, FEAT_FLOOR);
-			if (lit) sqinfo_on(c->squares[y + 1][x + 1].info, SQUARE_GLOW);
+			if (lit) sqinfo_on(sq_info(c, y + 1, x + 1), SQUARE_GLOW);
 
 			for (k = 0; k < n; k++) {
 				if (sets[k] == sb) sets[k] = sa;
@@ -887,12 +890,49 @@ struct chunk *labyrinth_gen(struct player *p) {
 
 /* ---------------- CAVERNS ---------------------- */
 
+/**
+ * Cavern layout as bitmaps, one bit per square (set for floor), packed 64
+ * squares to a word so the automaton can work on a word at a time.
+ */
+struct cavern_bits {
+	int h, w;
+	int words;		/* Words per row */
+	u64b *cur;		/* Floors now */
+	u64b *next;		/* Floors after the pass being run */
+	u64b *inner;	/* One row's interior (not the left or right edge) */
+};
+
+static struct cavern_bits *cavern_bits_new(int h, int w) {
+	struct cavern_bits *b = mem_zalloc(sizeof(*b));
+	int x;
+
+	b->h = h;
+	b->w = w;
+	b->words = (w + 63) / 64;
+	b->cur = mem_zalloc(h * b->words * sizeof(u64b));
+	b->next = mem_zalloc(h * b->words * sizeof(u64b));
+	b->inner = mem_zalloc(b->words * sizeof(u64b));
+	for (x = 1; x < w - 1; x++)
+		b->inner[x / 64] |= (u64b)1 << (x % 64);
+
+	return b;
+}
+
+static void cavern_bits_free(struct cavern_bits *b) {
+	mem_free(b->cur);
+	mem_free(b->next);
+	mem_free(b->inner);
+	mem_free(b);
+}
+
 /**
  * Initialize the dungeon array, with a random percentage of squares open.
+ * The floors are only recorded in the bitmaps; finish_cavern() places them.
  * \param c is the current chunk
+ * \param b is the cavern bitmap
  * \param density is the percentage of floors we are aiming for
  */
-static void init_cavern(struct chunk *c, int density) {
+static void init_cavern(struct chunk *c, struct cavern_bits *b, int density) {
     int h = c->height;
     int w = c->width;
     int size = h * w;
@@ -901,71 +941,107 @@ static void init_cavern(struct chunk *c, int density) {
 
     /* Fill the entire chunk with rock */
     fill_rectangle(c, 0, 0, h - 1, w - 1, FEAT_GRANITE, SQUARE_WALL_SOLID);
+	memset(b->cur, 0, h * b->words * sizeof(u64b));
 	
     while (count > 0) {
 		int y = randint1(h - 2);
 		int x = randint1(w - 2);
-		if (square_isrock(c, y, x)) {
-			square_set_feat(c, y, x, FEAT_FLOOR);
+		u64b *word = &b->cur[y * b->words + x / 64];
+		u64b bit = (u64b)1 << (x % 64);
+		if (!(*word & bit)) {
+			*word |= bit;
 			count--;
 		}
     }
 }
 
 /**
- * Return the number of walls (0-8) adjacent to this square.
- * \param c is the current chunk
- * \param y
- * \param x are the co-ordinates
+ * Add one bitmap of neighbours into a bit-sliced counter, so that
+ * s0..s3 hold the four bits of each square's running count.
  */
-static int count_adj_walls(struct chunk *c, int y, int x) {
-    int yd, xd;
-    int count = 0;
-
-    for (yd = -1; yd <= 1; yd++) {
-		for (xd = -1; xd <= 1; xd++) {
-			if (yd == 0 && xd == 0) continue;
-			if (square_isfloor(c, y + yd, x + xd)) continue;
-			count++;
+static void count_adj_bits(u64b n, u64b *s0, u64b *s1, u64b *s2, u64b *s3) {
+	u64b carry = *s0 & n;
+	*s0 ^= n;
+	n = carry;
+	carry = *s1 & n;
+	*s1 ^= n;
+	n = carry;
+	carry = *s2 & n;
+	*s2 ^= n;
+	*s3 |= carry;
+}
+
+/**
+ * Run a single pass of the cellular automata rules (4,5) on the cavern,
+ * 64 squares at a time.  A square with more than five adjacent walls (fewer
+ * than three adjacent floors) becomes wall, one with fewer than four (more
+ * than four floors) becomes floor, and the rest stay as they are.
+ * \param b is the cavern bitmap being mutated
+ */
+static void mutate_cavern(struct cavern_bits *b) {
+	int y, k;
+	int words = b->words;
+	u64b *swap;
+
+	for (y = 1; y < b->h - 1; y++) {
+		const u64b *row[3];
+		u64b *out = b->next + y * words;
+
+		row[0] = b->cur + (y - 1) * words;
+		row[1] = b->cur + y * words;
+		row[2] = b->cur + (y + 1) * words;
+
+		for (k = 0; k < words; k++) {
+			u64b s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			u64b to_floor, keep;
+			int r;
+
+			for (r = 0; r < 3; r++) {
+				/* Neighbours to the west and east, carrying across words */
+				u64b west = (row[r][k] << 1) |
+					(k > 0 ? row[r][k - 1] >> 63 : 0);
+				u64b east = (row[r][k] >> 1) |
+					(k < words - 1 ? row[r][k + 1] << 63 : 0);
+
+				count_adj_bits(west, &s0, &s1, &s2, &s3);
+				count_adj_bits(east, &s0, &s1, &s2, &s3);
+				if (r != 1)
+					count_adj_bits(row[r][k], &s0, &s1, &s2, &s3);
+			}
+
+			/* Five or more adjacent floors, or three or four */
+			to_floor = s3 | (s2 & (s1 | s0));
+			keep = ~s3 & ((~s2 & s1 & s0) | (s2 & ~s1 & ~s0));
+
+			out[k] = (to_floor | (keep & row[1][k])) & b->inner[k];
 		}
-    }
+	}
 
-    return count;
+	swap = b->cur;
+	b->cur = b->next;
+	b->next = swap;
 }
 
 /**
- * Run a single pass of the cellular automata rules (4,5) on the dungeon.
- * \param c is the chunk being mutated
+ * Place the features for a mutated cavern.  Every wall is marked solid.
+ * \param c is the current chunk
+ * \param b is the cavern bitmap
  */
-static void mutate_cavern(struct chunk *c) {
+static void finish_cavern(struct chunk *c, const struct cavern_bits *b) {
     int y, x;
-    int h = c->height;
-    int w = c->width;
 
-    int *temp = mem_zalloc(h * w * sizeof(int));
+    for (y = 1; y < c->height - 1; y++) {
+		const u64b *cur = b->cur + y * b->words;
 
-    for (y = 1; y < h - 1; y++) {
-		for (x = 1; x < w - 1; x++) {
-			int count = count_adj_walls(c, y, x);
-			if (count > 5)
-				temp[y * w + x] = FEAT_GRANITE;
-			else if (count < 4)
-				temp[y * w + x] = FEAT_FLOOR;
-			else
-				temp[y * w + x] = c->squares[y][x].feat;
-		}
-    }
+		for (x = 1; x < c->width - 1; x++) {
+			u64b bit = (u64b)1 << (x % 64);
 
-    for (y = 1; y < h - 1; y++) {
-		for (x = 1; x < w - 1; x++) {
-			if (temp[y * w + x] == FEAT_GRANITE)
-				set_marked_granite(c, y, x, SQUARE_WALL_SOLID);
+			if (cur[x / 64] & bit)
+				square_set_feat(c, y, x, FEAT_FLOOR);
 			else
-				square_set_feat(c, y, x, temp[y * w + x]);
+				set_marked_granite(c, y, x, SQUARE_WALL_SOLID);
 		}
     }
-
-    mem_free(temp);
 }
 
 /**
@@ -1007,62 +1083,34 @@ static void glow_point(struct chunk *c, int y, int x) {
     int i, j;
     for (i = -1; i <= -1; i++)
 		for (j = -1; j <= -1; j++)
-			sqinfo_on(c->squares[y + i][x + j].info, SQUARE_GLOW);
+			sqinfo_on(sq_info(c, y + i, x + j), SQUARE_GLOW);
 }
 #endif
 
 /**
- * Color a particular point, and all adjacent points.
- * \param c is the current chunk
- * \param colors is the array of current point colors
- * \param counts is the array of current color counts
- * \param y
- * \param x are the co-ordinates
- * \param color is the color we are coloring
- * \param diagonal controls whether we can progress diagonally
+ * Find the root of a point's set, halving the path to it as we go.
+ * \param parent is the array of set parents
+ * \param n is the point
  */
-static void build_color_point(struct chunk *c, int colors[], int counts[], int y, int x, int color, bool diagonal) {
-    int h = c->height;
-    int w = c->width;
-    int size = h * w;
-    struct queue *queue = q_new(size);
-
-    int dslimit = diagonal ? 8 : 4;
-
-    int *added = mem_zalloc(size * sizeof(int));
-    array_filler(added, 0, size);
-
-    q_push_int(queue, yx_to_i(y, x, w));
-
-    counts[color] = 0;
-
-    while (q_len(queue) > 0) {
-		int i, y2, x2;
-		int n2 = q_pop_int(queue);
-
-		i_to_yx(n2, w, &y2, &x2);
-
-		if (ignore_point(c, colors, y2, x2)) continue;
-
-		colors[n2] = color;
-		counts[color]++;
-
-		/*if (lit) glow_point(c, y2, x2);*/
-
-		for (i = 0; i < dslimit; i++) {
-			int y3 = y2 + yds[i];
-			int x3 = x2 + xds[i];
-			int n3 = yx_to_i(y3, x3, w);
-			if (ignore_point(c, colors, y3, x3)) continue;
-			if (added[n3]) continue;
-
-			q_push_int(queue, n3);
-			added[n3] = 1;
-		}
+static int find_region(int parent[], int n) {
+    while (parent[n] != n) {
+		parent[n] = parent[parent[n]];
+		n = parent[n];
     }
+    return n;
+}
 
-    mem_free(added);
-    q_free(queue);
+/**
+ * Merge the sets of two points; the lower root becomes the root of both.
+ * \param parent is the array of set parents
+ * \param a
+ * \param b are the points
+ */
+static void unite_regions(int parent[], int a, int b) {
+    a = find_region(parent, a);
+    b = find_region(parent, b);
+    if (a < b) parent[b] = a;
+    else if (b < a) parent[a] = b;
 }
 
 /**
@@ -1071,20 +1119,59 @@ static void build_color_point(struct chunk *c, int colors[], int counts[], int y
  * \param colors is the array of current point colors
  * \param counts is the array of current color counts
  * \param diagonal controls whether we can progress diagonally
+ *
+ * Regions are labelled in one scan, uniting each open point with the open
+ * points before it, then colored in order of their first point.
  */
 static void build_colors(struct chunk *c, int colors[], int counts[], bool diagonal) {
     int y, x;
     int h = c->height;
     int w = c->width;
+    int size = h * w;
     int color = 1;
 
+    /* Each open point's set, or -1 for points to ignore */
+    int *parent = mem_zalloc(size * sizeof(int));
+
     for (y = 0; y < h; y++) {
 		for (x = 0; x < w; x++) {
-			if (ignore_point(c, colors, y, x)) continue;
-			build_color_point(c, colors, counts, y, x, color, diagonal);
-			color++;
+			int n = yx_to_i(y, x, w);
+
+			if (ignore_point(c, colors, y, x)) {
+				parent[n] = -1;
+				continue;
+			}
+			parent[n] = n;
+
+			/* Join up with the open points already scanned */
+			if (x > 0 && parent[n - 1] >= 0)
+				unite_regions(parent, n, n - 1);
+			if (y > 0 && parent[n - w] >= 0)
+				unite_regions(parent, n, n - w);
+			if (!diagonal || y == 0) continue;
+			if (x > 0 && parent[n - w - 1] >= 0)
+				unite_regions(parent, n, n - w - 1);
+			if (x < w - 1 && parent[n - w + 1] >= 0)
+				unite_regions(parent, n, n - w + 1);
 		}
     }
+
+    /* Each root is the first point of its region, so is seen first */
+    for (y = 0; y < size; y++) {
+		int root;
+
+		if (parent[y] < 0) continue;
+		root = find_region(parent, y);
+		if (root == y) {
+			colors[y] = color;
+			counts[color++] = 0;
+		} else {
+			colors[y] = colors[root];
+		}
+		counts[colors[y]]++;
+    }
+
+    mem_free(parent);
 }
 
 /**
@@ -1134,17 +1221,6 @@ static int count_colors(int counts[], int size) {
     return num;
 }
 
-/**
- * Return the first color which has one or more active cells.
- * \param counts is the array of current color counts
- * \param size is the total area
- */
-static int first_color(int counts[], int size) {
-    int i;
-    for (i = 0; i < size; i++) if (counts[i] > 0) return i;
-    return -1;
-}
-
 /**
  * Find all cells of 'fromcolor' and repaint them to 'tocolor'.
  * \param colors is the array of current point colors
@@ -1254,25 +1330,151 @@ static void join_region(struct chunk *c, int colors[], int counts[], int color,
 
 
 /**
- * Start connecting regions, stopping when the cave is entirely connected.
+ * A place where the areas nearest to two regions meet.
+ */
+struct region_edge {
+	int cost;		/* Length of the tunnel joining the regions here */
+	int from;		/* The point on the lower colored region's side */
+	int to;			/* The point on the other side */
+};
+
+static int cmp_region_edge(const void *a, const void *b) {
+	const struct region_edge *ea = a;
+	const struct region_edge *eb = b;
+
+	if (ea->cost != eb->cost) return ea->cost - eb->cost;
+	if (ea->from != eb->from) return ea->from - eb->from;
+	return ea->to - eb->to;
+}
+
+/**
+ * Turn the path back from a point to the region it was reached from into
+ * tunnel.
+ * \param c is the current chunk
+ * \param colors is the array of current point colors
+ * \param owner is the color of the region nearest each point
+ * \param previous is the point each point was reached from
+ * \param n is the point to start from
+ */
+static void dig_to_region(struct chunk *c, int colors[], int owner[],
+	int previous[], int n)
+{
+    while (!colors[n]) {
+		int y, x;
+		i_to_yx(n, c->width, &y, &x);
+		colors[n] = owner[n];
+		if (!square_isperm(c, y, x) && !square_isvault(c, y, x)) {
+			square_set_feat(c, y, x, FEAT_FLOOR);
+		}
+		n = previous[n];
+    }
+}
+
+/**
+ * Connect all the regions, stopping when the cave is entirely connected.
  * \param c is the current chunk
  * \param colors is the array of current point colors
  * \param counts is the array of current color counts
+ *
+ * One search out from every region at once gives each point the region
+ * nearest to it, and the places where those areas meet make a graph of
+ * which regions neighbour which.  Joining the nearest pairs first, until
+ * everything is joined, gives the shortest set of tunnels.
  */
 static void join_regions(struct chunk *c, int colors[], int counts[]) {
+    int i;
     int h = c->height;
     int w = c->width;
     int size = h * w;
     int num = count_colors(counts, size);
 
-    /* While we have multiple colors (i.e. disconnected regions), join one of
-     * the regions to another one.
-     */
-    while (num > 1) {
-		int color = first_color(counts, size);
-		join_region(c, colors, counts, color, -1);
+    struct queue *queue;
+    int *owner, *previous, *dist, *parent;
+    struct region_edge *edges;
+    int num_edges = 0, max_edges = 64;
+
+    if (num < 2) return;
+
+    queue = q_new(size);
+    owner = mem_zalloc(size * sizeof(int));
+    previous = mem_zalloc(size * sizeof(int));
+    dist = mem_zalloc(size * sizeof(int));
+    parent = mem_zalloc(size * sizeof(int));
+    edges = mem_zalloc(max_edges * sizeof(*edges));
+    array_filler(previous, -1, size);
+
+    /* Start from every square of every region */
+    for (i = 0; i < size; i++) {
+		parent[i] = i;
+		if (!colors[i]) continue;
+		owner[i] = colors[i];
+		previous[i] = i;
+		q_push_int(queue, i);
+    }
+
+    /* Spread out, noting where the areas of two regions meet */
+    while (q_len(queue) > 0) {
+		int n = q_pop_int(queue);
+		int y, x;
+
+		i_to_yx(n, w, &y, &x);
+		for (i = 0; i < 4; i++) {
+			int y2 = y + yds[i];
+			int x2 = x + xds[i];
+			int n2;
+
+			if (y2 < 0 || y2 >= h) continue;
+			if (x2 < 0 || x2 >= w) continue;
+
+			n2 = yx_to_i(y2, x2, w);
+			if (previous[n2] < 0) {
+				owner[n2] = owner[n];
+				previous[n2] = n;
+				dist[n2] = dist[n] + 1;
+				q_push_int(queue, n2);
+			} else if (owner[n] < owner[n2]) {
+				if (num_edges == max_edges) {
+					max_edges *= 2;
+					edges = mem_realloc(edges, max_edges * sizeof(*edges));
+				}
+				edges[num_edges].cost = dist[n] + dist[n2] + 1;
+				edges[num_edges].from = n;
+				edges[num_edges].to = n2;
+				num_edges++;
+			}
+		}
+    }
+
+    /* Join the nearest pairs of regions not yet joined */
+    sort(edges, num_edges, sizeof(*edges), cmp_region_edge);
+    for (i = 0; i < num_edges && num > 1; i++) {
+		int from = edges[i].from;
+		int to = edges[i].to;
+
+		if (find_region(parent, owner[from]) == find_region(parent, owner[to]))
+			continue;
+
+		dig_to_region(c, colors, owner, previous, from);
+		dig_to_region(c, colors, owner, previous, to);
+		unite_regions(parent, owner[from], owner[to]);
 		num--;
     }
+
+    /* Everything is now one color */
+    for (i = 0; i < size; i++) {
+		if (!colors[i]) continue;
+		counts[colors[i]] = 0;
+		colors[i] = find_region(parent, colors[i]);
+    }
+    for (i = 0; i < size; i++)
+		if (colors[i]) counts[colors[i]]++;
+
+    q_free(queue);
+    mem_free(owner);
+    mem_free(previous);
+    mem_free(dist);
+    mem_free(parent);
+    mem_free(edges);
 }
 
 
@@ -1316,6 +1518,7 @@ struct chunk *cavern_chunk(int depth, int h, int w)
     int *counts = mem_zalloc(size * sizeof(int));
 
     int tries;
+	struct cavern_bits *b = cavern_bits_new(h, w);
 
 	struct chunk *c = cave_new(h, w);
 	c->depth = depth;
@@ -1326,8 +1529,9 @@ struct chunk *cavern_chunk(int depth, int h, int w)
 	/* Start trying to build caverns */
 	for (tries = 0; tries < MAX_CAVERN_TRIES; tries++) {
 		/* Build a random cavern and mutate it a number of times */
-		init_cavern(c, density);
-		for (i = 0; i < times; i++) mutate_cavern(c);
+		init_cavern(c, b, density);
+		for (i = 0; i < times; i++) mutate_cavern(b);
+		finish_cavern(c, b);
 
 		/* If there are enough open squares then we're done */
 		if (c->feat_count[FEAT_FLOOR] >= limit) {
@@ -1337,6 +1541,7 @@ struct chunk *cavern_chunk(int depth, int h, int w)
 		ROOM_LOG("cavern failed--try again (%d vs %d)",
 				 c->feat_count[FEAT_FLOOR], limit);
 	}
+	cavern_bits_free(b);
 
 	/* If we couldn't make a big enough cavern then fail */
 	if (tries == MAX_CAVERN_TRIES) {
@@ -1473,7 +1678,7 @@ static void town_gen_layout(struct chunk *c, struct player *p)
 				else
 					square_set_feat(c, y, x, FEAT_PERM);
 			}
-			sqinfo_off(c->squares[y][x].info, SQUARE_ROOM);
+			sqinfo_off(sq_info(c, y, x), SQUARE_ROOM);
 		}
 
 	/* Place stores */
@@ -1570,7 +1775,7 @@ struct chunk *town_gen(struct player *p)
 		for (y = 0; y < c_new->height; y++) {
 			bool found = FALSE;
 			for (x = 0; x < c_new->width; x++) {
-				if (c_new->squares[y][x].feat == FEAT_MORE) {
+				if (sq_feat(c_new, y, x) == FEAT_MORE) {
 					found = TRUE;
 					break;
 				}
@@ -1634,6 +1839,8 @@ struct chunk *modified_chunk(int depth, int height, int width)
 	dun->room_map = mem_zalloc(dun->row_blocks * sizeof(bool*));
 	for (i = 0; i < dun->row_blocks; i++)
 		dun->room_map[i] = mem_zalloc(dun->col_blocks * sizeof(bool));
+	dun->room_sums = mem_zalloc((dun->row_blocks + 1) *
+								(dun->col_blocks + 1) * sizeof(int));
 
     /* No rooms yet, pits or otherwise. */
     dun->pit_num = 0;
@@ -1671,6 +1878,7 @@ struct chunk *modified_chunk(int depth, int height, int width)
 	for (i = 0; i < dun->row_blocks; i++)
 		mem_free(dun->room_map[i]);
 	mem_free(dun->room_map);
+	mem_free(dun->room_sums);
 
     /* Hack -- Scramble the room order */
     for (i = 0; i < dun->cent_n; i++) {
@@ -1865,6 +2073,8 @@ struct chunk *moria_chunk(int depth, int height, int width)
 	dun->room_map = mem_zalloc(dun->row_blocks * sizeof(bool*));
 	for (i = 0; i < dun->row_blocks; i++)
 		dun->room_map[i] = mem_zalloc(dun->col_blocks * sizeof(bool));
+	dun->room_sums = mem_zalloc((dun->row_blocks + 1) *
+								(dun->col_blocks + 1) * sizeof(int));
 
     /* No rooms yet, pits or otherwise. */
     dun->pit_num = 0;
@@ -1902,6 +2112,7 @@ struct chunk *moria_chunk(int depth, int height, int width)
 	for (i = 0; i < dun->row_blocks; i++)
 		mem_free(dun->room_map[i]);
 	mem_free(dun->room_map);
+	mem_free(dun->room_sums);
 
     /* Hack -- Scramble the room order */
     for (i = 0; i < dun->cent_n; i++) {
@@ -59,15 +59,16 @@ struct chunk *chunk_write(int y0, int x0, int height, int width, bool monsters,
 	for (y = 0; y < height; y++) {
 		for (x = 0; x < width; x++) {
 			/* Terrain */
-			new->squares[y][x].feat = cave->squares[y0 + y][x0 + x].feat;
-			sqinfo_copy(new->squares[y][x].info,
-						cave->squares[y0 + y][x0 + x].info);
+			sq_feat(new, y, x) = sq_feat(cave, y0 + y, x0 + x);
+			square_update_planes(new, y, x);
+			sqinfo_copy(sq_info(new, y, x),
+						sq_info(cave, y0 + y, x0 + x));
 
 			/* Dungeon objects */
 			if (objects) {
 				struct object *obj = square_object(cave, y0 + y, x0 + x);
 				if (obj) {
-					new->squares[y][x].obj = obj;
+					sq_obj(new, y, x) = obj;
 					while (obj) {
 						/* Adjust stuff */
 						obj->iy = y;
@@ -78,7 +79,7 @@ struct chunk *chunk_write(int y0, int x0, int height, int width, bool monsters,
 
 			/* Monsters and held objects */
 			if (monsters) {
-				if (cave->squares[y0 + y][x0 + x].mon > 0) {
+				if (sq_mon(cave, y0 + y, x0 + x) > 0) {
 					monster_type *source_mon = square_monster(cave, y0 + y,
 															  x0 + x);
 					monster_type *dest_mon = NULL;
@@ -87,14 +88,21 @@ struct chunk *chunk_write(int y0, int x0, int height, int width, bool monsters,
 					if (!source_mon->race)
 						continue;
 
-					/* Copy over */
-					new->squares[y][x].mon = ++new->mon_cnt;
+					/* Copy over, with any missed turns made up */
+					cave_monster_unpark(cave, source_mon->midx);
+					sq_mon(new, y, x) = ++new->mon_cnt;
 					dest_mon = cave_monster(new, new->mon_cnt);
 					memcpy(dest_mon, source_mon, sizeof(*source_mon));
+					memcpy(cave_monster_known(new, new->mon_cnt),
+						   cave_monster_known(cave, source_mon->midx),
+						   sizeof(struct monster_known_pstate));
 
 					/* Adjust position */
 					dest_mon->fy = y;
 					dest_mon->fx = x;
+					cave_monster_index_add(new, new->mon_cnt);
+					cave_light_register(new, new->mon_cnt);
+					cave_monster_sched_add(new, new->mon_cnt);
 
 					/* Held objects */
 					if (objects && source_mon->held_obj)
@@ -107,9 +115,9 @@ struct chunk *chunk_write(int y0, int x0, int height, int width, bool monsters,
 			/* Traps */
 			if (traps) {
 				/* Copy over */
-				struct trap *trap = cave->squares[y][x].trap;
-				new->squares[y][x].trap = trap;
-				cave->squares[y][x].trap = NULL;
+				struct trap *trap = sq_trap(cave, y, x);
+				sq_trap(new, y, x) = trap;
+				sq_trap(cave, y, x) = NULL;
 
 				/* Adjust position */
 				trap->fy = y;
@@ -254,6 +262,7 @@ bool chunk_copy(struct chunk *dest, struct chunk *source, int y0, int x0,
 	int i;
 	int y, x;
 	int h = source->height, w = source->width;
+	bool transformed = (rotate % 4) || reflect;
 
 	/* Check bounds */
 	if (rotate % 1) {
@@ -264,6 +273,18 @@ bool chunk_copy(struct chunk *dest, struct chunk *source, int y0, int x0,
 			return FALSE;
 	}
 
+	/* Untransformed terrain can be copied a plane row at a time */
+	if (!transformed) {
+		for (y = 0; y < h; y++) {
+			memcpy(&sq_feat(dest, y0 + y, x0), &sq_feat(source, y, 0),
+				   w * sizeof(byte));
+			memcpy(sq_info(dest, y0 + y, x0), sq_info(source, y, 0),
+				   w * SQUARE_SIZE * sizeof(bitflag));
+			for (x = 0; x < w; x++)
+				square_update_planes(dest, y0 + y, x0 + x);
+		}
+	}
+
 	/* Write the location stuff */
 	for (y = 0; y < h; y++) {
 		for (x = 0; x < w; x++) {
@@ -273,14 +294,17 @@ bool chunk_copy(struct chunk *dest, struct chunk *source, int y0, int x0,
 			symmetry_transform(&dest_y, &dest_x, y0, x0, h, w, rotate, reflect);
 
 			/* Terrain */
-			dest->squares[dest_y][dest_x].feat = source->squares[y][x].feat;
-			sqinfo_copy(dest->squares[dest_y][dest_x].info,
-						source->squares[y][x].info);
+			if (transformed) {
+				sq_feat(dest, dest_y, dest_x) = sq_feat(source, y, x);
+				square_update_planes(dest, dest_y, dest_x);
+				sqinfo_copy(sq_info(dest, dest_y, dest_x),
+							sq_info(source, y, x));
+			}
 
 			/* Dungeon objects */
 			if (square_object(source, y, x)) {
 				struct object *obj;
-				dest->squares[dest_y][dest_x].obj = square_object(source, y, x);
+				sq_obj(dest, dest_y, dest_x) = square_object(source, y, x);
 
 				for (obj = square_object(source, y, x); obj; obj = obj->next) {
 					/* Adjust position */
@@ -290,7 +314,7 @@ bool chunk_copy(struct chunk *dest, struct chunk *source, int y0, int x0,
 			}
 
 			/* Monsters */
-			if (source->squares[y][x].mon > 0) {
+			if (sq_mon(source, y, x) > 0) {
 				monster_type *source_mon = square_monster(source, y, x);
 				monster_type *dest_mon = NULL;
 				int idx;
@@ -306,15 +330,22 @@ bool chunk_copy(struct chunk *dest, struct chunk *source, int y0, int x0,
 				if (!idx)
 					break;
 
-				/* Copy over */
+				/* Copy over, with any missed turns made up */
+				cave_monster_unpark(source, source_mon->midx);
 				dest_mon = cave_monster(dest, idx);
-				dest->squares[dest_y][dest_x].mon = idx;
+				sq_mon(dest, dest_y, dest_x) = idx;
 				memcpy(dest_mon, source_mon, sizeof(*source_mon));
+				memcpy(cave_monster_known(dest, idx),
+					   cave_monster_known(source, source_mon->midx),
+					   sizeof(struct monster_known_pstate));
 
 				/* Adjust stuff */
 				dest_mon->midx = idx;
 				dest_mon->fy = dest_y;
 				dest_mon->fx = dest_x;
+				cave_monster_index_add(dest, idx);
+				cave_light_register(dest, idx);
+				cave_monster_sched_add(dest, idx);
 
 				/* Held objects */
 				if (source_mon->held_obj)
@@ -322,9 +353,9 @@ bool chunk_copy(struct chunk *dest, struct chunk *source, int y0, int x0,
 			}
 
 			/* Traps */
-			if (source->squares[y][x].trap) {
-				struct trap *trap = source->squares[y][x].trap;
-				dest->squares[y][x].trap = trap;
+			if (sq_trap(source, y, x)) {
+				struct trap *trap = sq_trap(source, y, x);
+				sq_trap(dest, y, x) = trap;
 
 				/* Traverse the trap list */
 				while (trap) {
@@ -336,8 +367,8 @@ bool chunk_copy(struct chunk *dest, struct chunk *source, int y0, int x0,
 			}
 
 			/* Player */
-			if (source->squares[y][x].mon == -1) 
-				dest->squares[dest_y][dest_x].mon = -1;
+			if (sq_mon(source, y, x) == -1) 
+				sq_mon(dest, dest_y, dest_x) = -1;
 		}
 	}
 
@@ -368,7 +399,7 @@ void chunk_validate_objects(struct chunk *c) {
 		for (x = 0; x < c->width; x++) {
 			for (obj = square_object(c, y, x); obj; obj = obj->next)
 				assert(obj->tval != 0);
-			if (c->squares[y][x].mon > 0) {
+			if (sq_mon(c, y, x) > 0) {
 				monster_type *mon = square_monster(c, y, x);
 				if (mon->held_obj)
 					for (obj = mon->held_obj; obj; obj = obj->next)
@@ -172,7 +172,7 @@ bool mon_restrict(const char *monster_type, int depth, bool unique_ok)
 			return FALSE;
 
 		/* Prepare allocation table */
-		get_mon_num_prep(mon_pit_hook);
+		get_mon_num_prep_cached(mon_pit_hook, dun->pit_type);
 		return TRUE;
 	}
 }
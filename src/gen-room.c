@@ -99,9 +99,9 @@ static void generate_room(struct chunk *c, int y1, int x1, int y2, int x2, int l
 	int y, x;
 	for (y = y1; y <= y2; y++)
 		for (x = x1; x <= x2; x++) {
-			sqinfo_on(c->squares[y][x].info, SQUARE_ROOM);
+			sqinfo_on(sq_info(c, y, x), SQUARE_ROOM);
 			if (light)
-				sqinfo_on(c->squares[y][x].info, SQUARE_GLOW);
+				sqinfo_on(sq_info(c, y, x), SQUARE_GLOW);
 		}
 }
 
@@ -121,7 +121,7 @@ void generate_mark(struct chunk *c, int y1, int x1, int y2, int x2, int flag)
 
 	for (y = y1; y <= y2; y++) {
 		for (x = x1; x <= x2; x++) {
-			sqinfo_on(c->squares[y][x].info, flag);
+			sqinfo_on(sq_info(c, y, x), flag);
 		}
 	}
 }
@@ -198,10 +198,10 @@ static void fill_xrange(struct chunk *c, int y, int x1, int x2, int feat,
 	int x;
 	for (x = x1; x <= x2; x++) {
 		square_set_feat(c, y, x, feat);
-		sqinfo_on(c->squares[y][x].info, SQUARE_ROOM);
-		if (flag) sqinfo_on(c->squares[y][x].info, flag);
+		sqinfo_on(sq_info(c, y, x), SQUARE_ROOM);
+		if (flag) sqinfo_on(sq_info(c, y, x), flag);
 		if (light)
-			sqinfo_on(c->squares[y][x].info, SQUARE_GLOW);
+			sqinfo_on(sq_info(c, y, x), SQUARE_GLOW);
 	}
 }
 
@@ -222,10 +222,10 @@ static void fill_yrange(struct chunk *c, int x, int y1, int y2, int feat,
 	int y;
 	for (y = y1; y <= y2; y++) {
 		square_set_feat(c, y, x, feat);
-		sqinfo_on(c->squares[y][x].info, SQUARE_ROOM);
-		if (flag) sqinfo_on(c->squares[y][x].info, flag);
+		sqinfo_on(sq_info(c, y, x), SQUARE_ROOM);
+		if (flag) sqinfo_on(sq_info(c, y, x), flag);
 		if (light)
-			sqinfo_on(c->squares[y][x].info, SQUARE_GLOW);
+			sqinfo_on(sq_info(c, y, x), SQUARE_GLOW);
 	}
 }
 
@@ -655,14 +655,14 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
 							square_set_feat(c, y, x, feat);
 
 							if (tf_has(f_ptr->flags, TF_FLOOR))
-								sqinfo_on(c->squares[y][x].info, SQUARE_ROOM);
+								sqinfo_on(sq_info(c, y, x), SQUARE_ROOM);
 							else
-								sqinfo_off(c->squares[y][x].info, SQUARE_ROOM);
+								sqinfo_off(sq_info(c, y, x), SQUARE_ROOM);
 
 							if (light)
-								sqinfo_on(c->squares[y][x].info, SQUARE_GLOW);
+								sqinfo_on(sq_info(c, y, x), SQUARE_GLOW);
 							else
-								sqinfo_off(c->squares[y][x].info, SQUARE_GLOW);
+								sqinfo_off(sq_info(c, y, x), SQUARE_GLOW);
 						}
 
 						/* If new feature is non-floor passable terrain,
@@ -670,13 +670,13 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
 						else {
 							/* Replace old feature entirely in some cases. */
 							if (tf_has(f_ptr->flags, TF_SMOOTH)) {
-								if (tf_has(f_info[c->squares[y][x].feat].flags, 
+								if (tf_has(f_info[sq_feat(c, y, x)].flags, 
 										   TF_FLOOR))
 									square_set_feat(c, y, x, feat);
 							}
 							/* Make denser in the middle. */
 							else {
-								if ((tf_has(f_info[c->squares[y][x].feat].flags,
+								if ((tf_has(f_info[sq_feat(c, y, x)].flags,
 											TF_FLOOR))
 									&& (randint1(max_dist + 5) >= dist + 5))
 									square_set_feat(c, y, x, feat);
@@ -684,7 +684,7 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
 
 							/* Light grid. */
 							if (light)
-								sqinfo_on(c->squares[y][x].info, SQUARE_GLOW);
+								sqinfo_on(sq_info(c, y, x), SQUARE_GLOW);
 						}
 					}
 
@@ -703,7 +703,7 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
 		for (y = y1 + 1; y < y2; y++) {
 			for (x = x1 + 1; x < x2; x++) {
 				/* Floor grids only */
-				if (tf_has(f_info[c->squares[y][x].feat].flags, TF_FLOOR)) {
+				if (tf_has(f_info[sq_feat(c, y, x)].flags, TF_FLOOR)) {
 					/* Look in all directions. */
 					for (d = 0; d < 8; d++) {
 						/* Extract adjacent location */
@@ -711,14 +711,14 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
 						int xx = x + ddx_ddd[d];
 
 						/* Join to room */
-						sqinfo_on(c->squares[yy][xx].info, SQUARE_ROOM);
+						sqinfo_on(sq_info(c, yy, xx), SQUARE_ROOM);
 
 						/* Illuminate if requested. */
 						if (light)
-							sqinfo_on(c->squares[yy][xx].info, SQUARE_GLOW);
+							sqinfo_on(sq_info(c, yy, xx), SQUARE_GLOW);
 
 						/* Look for dungeon granite. */
-						if (c->squares[yy][xx].feat == FEAT_GRANITE) {
+						if (sq_feat(c, yy, xx) == FEAT_GRANITE) {
 							/* Mark as outer wall. */
 							set_marked_granite(c, yy, xx, SQUARE_WALL_OUTER);
 						}
@@ -734,6 +734,43 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
 
 
 
+/**
+ * Count the reserved blocks in by1 <= by <= by2, bx1 <= bx <= bx2.
+ *
+ * dun->room_sums holds, for each block, the number of reserved blocks above
+ * and to the left of it (inclusive), offset by one row and column so that
+ * the edges need no special cases.
+ */
+static int room_map_used(int by1, int bx1, int by2, int bx2)
+{
+	int stride = dun->col_blocks + 1;
+	int *sums = dun->room_sums;
+
+	return sums[(by2 + 1) * stride + bx2 + 1] - sums[by1 * stride + bx2 + 1]
+		- sums[(by2 + 1) * stride + bx1] + sums[by1 * stride + bx1];
+}
+
+/**
+ * Reserve the blocks in by1 <= by <= by2, bx1 <= bx <= bx2, and bring the
+ * sums for the rows from by1 down up to date.
+ */
+static void room_map_reserve(int by1, int bx1, int by2, int bx2)
+{
+	int stride = dun->col_blocks + 1;
+	int *sums = dun->room_sums;
+	int by, bx;
+
+	for (by = by1; by <= by2; by++)
+		for (bx = bx1; bx <= bx2; bx++)
+			dun->room_map[by][bx] = TRUE;
+
+	for (by = by1; by < dun->row_blocks; by++)
+		for (bx = 0; bx < dun->col_blocks; bx++)
+			sums[(by + 1) * stride + bx + 1] = (dun->room_map[by][bx] ? 1 : 0)
+				+ sums[by * stride + bx + 1] + sums[(by + 1) * stride + bx]
+				- sums[by * stride + bx];
+}
+
 /**
  * Find a good spot for the next room.
  *
@@ -746,7 +783,8 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
  * Find and allocate a free space in the dungeon large enough to hold
  * the room calling this function.
  *
- * We allocate space in blocks.
+ * We allocate space in blocks.  Each guess is checked in constant time,
+ * however many blocks the room covers; see room_map_used().
  *
  * Be careful to include the edges of the room in height and width!
  *
@@ -756,9 +794,7 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
 static bool find_space(int *y, int *x, int height, int width)
 {
 	int i;
-	int by, bx, by1, bx1, by2, bx2;
-
-	bool filled;
+	int by1, bx1, by2, bx2;
 
 	/* Find out how many blocks we need. */
 	int blocks_high = 1 + ((height - 1) / dun->block_hgt);
@@ -766,8 +802,6 @@ static bool find_space(int *y, int *x, int height, int width)
 
 	/* We'll allow twenty-five guesses. */
 	for (i = 0; i < 25; i++) {
-		filled = FALSE;
-
 		/* Pick a top left block at random */
 		by1 = randint0(dun->row_blocks);
 		bx1 = randint0(dun->col_blocks);
@@ -780,16 +814,11 @@ static bool find_space(int *y, int *x, int height, int width)
 		if (by1 < 0 || by2 >= dun->row_blocks) continue;
 		if (bx1 < 0 || bx2 >= dun->col_blocks) continue;
 
-		/* Verify open space */
-		for (by = by1; by <= by2; by++) {
-			for (bx = bx1; bx <= bx2; bx++) {
-				if (dun->room_map[by][bx])
-					filled = TRUE;
-			}
-		}
-
 		/* If space filled, try again. */
-		if (filled)	continue;
+		if (room_map_used(by1, bx1, by2, bx2)) {
+			gen_stats.space_misses++;
+			continue;
+		}
 
 		/* Get the location of the room */
 		*y = ((by1 + by2 + 1) * dun->block_hgt) / 2;
@@ -803,11 +832,7 @@ static bool find_space(int *y, int *x, int height, int width)
 		}
 
 		/* Reserve some blocks */
-		for (by = by1; by <= by2; by++) {
-			for (bx = bx1; bx <= bx2; bx++) {
-				dun->room_map[by][bx] = TRUE;
-			}
-		}
+		room_map_reserve(by1, bx1, by2, bx2);
 
 		/* Success. */
 		return (TRUE);
@@ -1548,7 +1573,7 @@ bool build_nest(struct chunk *c, int y0, int x0)
 	alloc_obj = dun->pit_type->obj_rarity;
 	
 	/* Prepare allocation table */
-	get_mon_num_prep(mon_pit_hook);
+	get_mon_num_prep_cached(mon_pit_hook, dun->pit_type);
 
 	/* Pick some monster types */
 	for (i = 0; i < 64; i++) {
@@ -1667,7 +1692,7 @@ bool build_pit(struct chunk *c, int y0, int x0)
 	alloc_obj = dun->pit_type->obj_rarity;
 	
 	/* Prepare allocation table */
-	get_mon_num_prep(mon_pit_hook);
+	get_mon_num_prep_cached(mon_pit_hook, dun->pit_type);
 
 	/* Pick some monster types */
 	for (i = 0; i < 16; i++) {
@@ -1920,9 +1945,9 @@ static bool build_room_template(struct chunk *c, int y0, int x0, int ymax, int x
 			}
 
 			/* Part of a room */
-			sqinfo_on(c->squares[y][x].info, SQUARE_ROOM);
+			sqinfo_on(sq_info(c, y, x), SQUARE_ROOM);
 			if (light)
-				sqinfo_on(c->squares[y][x].info, SQUARE_GLOW);
+				sqinfo_on(sq_info(c, y, x), SQUARE_GLOW);
 		}
 	}
 
@@ -1993,8 +2018,10 @@ bool build_vault(struct chunk *c, int y0, int x0, struct vault *v)
 
 	/* Find and reserve some space in the dungeon.  Get center of room. */
 	if ((y0 >= c->height) || (x0 >= c->width)) {
-		if (!find_space(&y0, &x0, v->hgt + 2, v->wid + 2))
+		if (!find_space(&y0, &x0, v->hgt + 2, v->wid + 2)) {
+			gen_stats.vault_fails++;
 			return (FALSE);
+		}
 	}
 
 	/* Get the room corners */
@@ -2073,8 +2100,8 @@ bool build_vault(struct chunk *c, int y0, int x0, struct vault *v)
 			}
 
 			/* Part of a vault */
-			sqinfo_on(c->squares[y][x].info, SQUARE_ROOM);
-			if (icky) sqinfo_on(c->squares[y][x].info, SQUARE_VAULT);
+			sqinfo_on(sq_info(c, y, x), SQUARE_ROOM);
+			if (icky) sqinfo_on(sq_info(c, y, x), SQUARE_VAULT);
 		}
 	}
 
@@ -2416,8 +2443,8 @@ bool build_moria(struct chunk *c, int y0, int x0)
  */
 static void make_inner_chamber_wall(struct chunk *c, int y, int x)
 {
-	if ((c->squares[y][x].feat != FEAT_GRANITE) &&
-		(c->squares[y][x].feat != FEAT_MAGMA))
+	if ((sq_feat(c, y, x) != FEAT_GRANITE) &&
+		(sq_feat(c, y, x) != FEAT_MAGMA))
 		return;
 	if (square_iswall_outer(c, y, x)) return;
 	if (square_iswall_solid(c, y, x)) return;
@@ -2491,7 +2518,7 @@ static void make_chamber(struct chunk *c, int y1, int x1, int y2, int x2)
 			int xx = x + ddx_ddd[d];
 
 			/* No doors beside doors. */
-			if (c->squares[yy][xx].feat == FEAT_OPEN)
+			if (sq_feat(c, yy, xx) == FEAT_OPEN)
 				break;
 
 			/* Count the inner walls. */
@@ -2533,14 +2560,14 @@ static void hollow_out_room(struct chunk *c, int y, int x)
 		xx = x + ddx_ddd[d];
 
 		/* Change magma to floor. */
-		if (c->squares[yy][xx].feat == FEAT_MAGMA) {
+		if (sq_feat(c, yy, xx) == FEAT_MAGMA) {
 			square_set_feat(c, yy, xx, FEAT_FLOOR);
 
 			/* Hollow out the room. */
 			hollow_out_room(c, yy, xx);
 		}
 		/* Change open door to broken door. */
-		else if (c->squares[yy][xx].feat == FEAT_OPEN) {
+		else if (sq_feat(c, yy, xx) == FEAT_OPEN) {
 			square_set_feat(c, yy, xx, FEAT_BROKEN);
 
 			/* Hollow out the (new) room. */
@@ -2658,14 +2685,14 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 				int xx = x + ddx_ddd[d];
 
 				/* Count the walls and dungeon granite. */
-				if ((c->squares[yy][xx].feat == FEAT_GRANITE) &&
+				if ((sq_feat(c, yy, xx) == FEAT_GRANITE) &&
 					(!square_iswall_outer(c, yy, xx)) &&
 					(!square_iswall_solid(c, yy, xx)))
 					count++;
 			}
 
 			/* Five adjacent walls: Change non-chamber to wall. */
-			if ((count == 5) && (c->squares[y][x].feat != FEAT_MAGMA))
+			if ((count == 5) && (sq_feat(c, y, x) != FEAT_MAGMA))
 				set_marked_granite(c, y, x, SQUARE_WALL_INNER);
 
 			/* More than five adjacent walls: Change anything to wall. */
@@ -2678,7 +2705,7 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 	for (i = 0; i < 50; i++) {
 		y = y1 + ABS(y2 - y1) / 4 + randint0(ABS(y2 - y1) / 2);
 		x = x1 + ABS(x2 - x1) / 4 + randint0(ABS(x2 - x1) / 2);
-		if (c->squares[y][x].feat == FEAT_MAGMA)
+		if (sq_feat(c, y, x) == FEAT_MAGMA)
 			break;
 	}
 
@@ -2695,7 +2722,7 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 		for (y = y1; y < y2; y++) {
 			for (x = x1; x < x2; x++) {
 				/* Current grid must be magma. */
-				if (c->squares[y][x].feat != FEAT_MAGMA) continue;
+				if (sq_feat(c, y, x) != FEAT_MAGMA) continue;
 
 				/* Stay legal. */
 				if (!square_in_bounds_fully(c, y, x)) continue;
@@ -2718,7 +2745,7 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 					if (!square_in_bounds(c, yy2, xx2)) continue;
 
 					/* If we find open floor, place a door. */
-					if (c->squares[yy2][xx2].feat == FEAT_FLOOR) {
+					if (sq_feat(c, yy2, xx2) == FEAT_FLOOR) {
 						joy = TRUE;
 
 						/* Make a broken door in the wall grid. */
@@ -2739,7 +2766,7 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 						if (!square_in_bounds(c, yy3, xx3)) continue;
 
 						/* If we /now/ find floor, make a tunnel. */
-						if (c->squares[yy3][xx3].feat == FEAT_FLOOR) {
+						if (sq_feat(c, yy3, xx3) == FEAT_FLOOR) {
 							joy = TRUE;
 
 							/* Turn both wall grids into floor. */
@@ -2765,9 +2792,9 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 	/* Turn broken doors into a random kind of door, remove open doors. */
 	for (y = y1; y <= y2; y++) {
 		for (x = x1; x <= x2; x++) {
-			if (c->squares[y][x].feat == FEAT_OPEN)
+			if (sq_feat(c, y, x) == FEAT_OPEN)
 				set_marked_granite(c, y, x, SQUARE_WALL_INNER);
-			else if (c->squares[y][x].feat == FEAT_BROKEN)
+			else if (sq_feat(c, y, x) == FEAT_BROKEN)
 				place_random_door(c, y, x);
 		}
 	}
@@ -2780,7 +2807,7 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 		for (x = (x1 - 1 > 0 ? x1 - 1 : 0);
 			 x < (x2 + 2 < c->width ? x2 + 2 : c->width); x++) {
 			if (square_iswall_inner(c, y, x)
-				|| (c->squares[y][x].feat == FEAT_MAGMA)) {
+				|| (sq_feat(c, y, x) == FEAT_MAGMA)) {
 				for (d = 0; d < 9; d++) {
 					/* Extract adjacent location */
 					int yy = y + ddy_ddd[d];
@@ -2790,14 +2817,14 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 					if (!square_in_bounds(c, yy, xx)) continue;
 
 					/* No floors allowed */
-					if (c->squares[yy][xx].feat == FEAT_FLOOR) break;
+					if (sq_feat(c, yy, xx) == FEAT_FLOOR) break;
 
 					/* Turn me into dungeon granite. */
 					if (d == 8)
 						set_marked_granite(c, y, x, SQUARE_NONE);
 				}
 			}
-			if (tf_has(f_info[c->squares[y][x].feat].flags, TF_FLOOR)) {
+			if (tf_has(f_info[sq_feat(c, y, x)].flags, TF_FLOOR)) {
 				for (d = 0; d < 9; d++) {
 					/* Extract adjacent location */
 					int yy = y + ddy_ddd[d];
@@ -2807,10 +2834,10 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 					if (!square_in_bounds(c, yy, xx)) continue;
 
 					/* Turn into room. */
-					sqinfo_on(c->squares[yy][xx].info, SQUARE_ROOM);
+					sqinfo_on(sq_info(c, yy, xx), SQUARE_ROOM);
 
 					/* Illuminate if requested. */
-					if (light) sqinfo_on(c->squares[yy][xx].info, SQUARE_GLOW);
+					if (light) sqinfo_on(sq_info(c, yy, xx), SQUARE_GLOW);
 				}
 			}
 		}
@@ -2832,7 +2859,7 @@ bool build_room_of_chambers(struct chunk *c, int y0, int x0)
 					int xx = x + ddx_ddd[d];
 
 					/* Look for dungeon granite */
-					if ((c->squares[yy][xx].feat == FEAT_GRANITE) && 
+					if ((sq_feat(c, yy, xx) == FEAT_GRANITE) && 
 						(!square_iswall_inner(c, y, x)) &&
 						(!square_iswall_outer(c, y, x)) &&
 						(!square_iswall_solid(c, y, x)))
@@ -2969,7 +2996,8 @@ bool room_build(struct chunk *c, int by0, int bx0, struct room_profile profile,
 	int bx2 = bx0 + profile.width / dun->block_wid;
 
 	int y, x;
-	int by, bx;
+	bool built;
+	clock_t start;
 
 	/* Enforce the room profile's minimum depth */
 	if (c->depth < profile.level) return FALSE;
@@ -2984,27 +3012,30 @@ bool room_build(struct chunk *c, int by0, int bx0, struct room_profile profile,
 	/* Does the profile allocate space, or the room find it? */
 	if (finds_own_space) {
 		/* Try to build a room, pass silly place so room finds its own */
-		if (!profile.builder(c, c->height, c->width))
+		start = gen_timer_start();
+		built = profile.builder(c, c->height, c->width);
+		if (gen_stats.on)
+			gen_timer_stop(gen_room_timer(profile.builder), start, built);
+		if (!built)
 			return FALSE;
 	} else {
 		/* Never run off the screen */
 		if (by1 < 0 || by2 >= dun->row_blocks) return FALSE;
 		if (bx1 < 0 || bx2 >= dun->col_blocks) return FALSE;
 
-		/* Verify open space */
-		for (by = by1; by <= by2; by++) {
-			for (bx = bx1; bx <= bx2; bx++) {
-				/* previous rooms prevent new ones */
-				if (dun->room_map[by][bx]) return FALSE;
-			}
-		}
+		/* Verify open space; previous rooms prevent new ones */
+		if (room_map_used(by1, bx1, by2, bx2)) return FALSE;
 
 		/* Get the location of the room */
 		y = ((by1 + by2 + 1) * dun->block_hgt) / 2;
 		x = ((bx1 + bx2 + 1) * dun->block_wid) / 2;
 
 		/* Try to build a room */
-		if (!profile.builder(c, y, x)) return FALSE;
+		start = gen_timer_start();
+		built = profile.builder(c, y, x);
+		if (gen_stats.on)
+			gen_timer_stop(gen_room_timer(profile.builder), start, built);
+		if (!built) return FALSE;
 
 		/* Save the room location */
 		if (dun->cent_n < z_info->level_room_max) {
@@ -3014,11 +3045,8 @@ bool room_build(struct chunk *c, int by0, int bx0, struct room_profile profile,
 		}
 
 		/* Reserve some blocks */
-		for (by = by1; by < by2; by++) {
-			for (bx = bx1; bx < bx2; bx++) {
-				dun->room_map[by][bx] = TRUE;
-			}
-		}
+		if (by2 > by1 && bx2 > bx1)
+			room_map_reserve(by1, bx1, by2 - 1, bx2 - 1);
 	}
 
 	/* Count pit/nests rooms */
@@ -231,9 +231,22 @@ static bool cave_find_in_range(struct chunk *c, int *y, int y1, int y2,
  * \param y found y co-ordinate
  * \param x found x co-ordinate
  * \return success
+ *
+ * Only floors can be empty, so guess among the chunk's floors first; each
+ * empty square is as likely as any other to be picked.  Only a nearly full
+ * level falls back to searching every square.
  */
 bool find_empty(struct chunk *c, int *y, int *x)
 {
+    int tries;
+
+    for (tries = 0; tries < 64 && c->floor_n; tries++) {
+		int n = c->floor_list[randint0(c->floor_n)];
+
+		i_to_yx(n, c->width, y, x);
+		if (square_isempty(c, *y, *x)) return TRUE;
+    }
+
     return cave_find(c, y, x, square_isempty);
 }
 
@@ -607,6 +620,7 @@ bool alloc_object(struct chunk *c, int set, int typ, int depth, byte origin)
 {
     int x = 0, y = 0;
     int tries = 0;
+    clock_t start = gen_timer_start();
 
     /* Pick a "legal" spot */
     while (tries < 2000) {
@@ -621,7 +635,10 @@ bool alloc_object(struct chunk *c, int set, int typ, int depth, byte origin)
 		if (set & SET_ROOM && square_isroom(c, y, x)) break;
     }
 
-    if (tries == 2000) return FALSE;
+    if (tries == 2000) {
+		gen_timer_stop(&gen_stats.alloc, start, FALSE);
+		return FALSE;
+    }
 
     /* Place something */
     switch (typ) {
@@ -632,6 +649,7 @@ bool alloc_object(struct chunk *c, int set, int typ, int depth, byte origin)
     case TYP_GOOD: place_object(c, y, x, depth, TRUE, FALSE, origin, 0); break;
     case TYP_GREAT: place_object(c, y, x, depth, TRUE, TRUE, origin, 0); break;
     }
+    gen_timer_stop(&gen_stats.alloc, start, TRUE);
     return TRUE;
 }
 
@@ -76,6 +76,16 @@ static const struct {
 	#undef ROOM
 };
 
+static struct gen_timer profile_timers[N_ELEMENTS(cave_builders)];
+static struct gen_timer room_timers[N_ELEMENTS(room_builders)];
+
+struct gen_stats gen_stats = {
+	FALSE, { 0, 0, 0 }, { 0, 0, 0 },
+	profile_timers, N_ELEMENTS(cave_builders),
+	room_timers, N_ELEMENTS(room_builders),
+	0, 0
+};
+
 
 /**
  * Parsing functions for dungeon_profile.txt
@@ -647,7 +657,7 @@ static void place_feeling(struct chunk *c)
 				continue;
 
 			/* Set the cave square appropriately */
-			sqinfo_on(c->squares[y][x].info, SQUARE_FEEL);
+			sqinfo_on(sq_info(c, y, x), SQUARE_FEEL);
 			
 			break;
 		}
@@ -842,6 +852,114 @@ static void cave_clear(struct chunk *c, struct player *p)
 }
 
 
+/**
+ * ------------------------------------------------------------------------
+ * Generation statistics
+ * ------------------------------------------------------------------------ */
+/**
+ * Start timing a phase; costs nothing unless stats are being gathered.
+ */
+clock_t gen_timer_start(void)
+{
+	return gen_stats.on ? clock() : 0;
+}
+
+/**
+ * Finish timing a phase started with gen_timer_start().
+ * \param t is the phase's timer
+ * \param start is what gen_timer_start() returned
+ * \param ok is whether the phase succeeded
+ */
+void gen_timer_stop(struct gen_timer *t, clock_t start, bool ok)
+{
+	if (!gen_stats.on) return;
+
+	t->calls++;
+	if (!ok) t->fails++;
+	t->ticks += clock() - start;
+}
+
+/**
+ * Find the timer for a cave profile's builder.
+ */
+static struct gen_timer *gen_profile_timer(cave_builder builder)
+{
+	size_t i;
+
+	for (i = 0; i < N_ELEMENTS(cave_builders); i++)
+		if (cave_builders[i].builder == builder)
+			return &profile_timers[i];
+
+	return NULL;
+}
+
+/**
+ * Find the timer for a room builder.
+ */
+struct gen_timer *gen_room_timer(room_builder builder)
+{
+	size_t i;
+
+	for (i = 0; i < N_ELEMENTS(room_builders); i++)
+		if (room_builders[i].builder == builder)
+			return &room_timers[i];
+
+	return NULL;
+}
+
+/**
+ * Clear all the generation statistics, leaving gen_stats.on alone.
+ */
+void gen_stats_reset(void)
+{
+	memset(&gen_stats.level, 0, sizeof(gen_stats.level));
+	memset(&gen_stats.alloc, 0, sizeof(gen_stats.alloc));
+	memset(profile_timers, 0, sizeof(profile_timers));
+	memset(room_timers, 0, sizeof(room_timers));
+	gen_stats.space_misses = 0;
+	gen_stats.vault_fails = 0;
+}
+
+static void gen_timer_dump(ang_file *f, const char *name,
+						   const struct gen_timer *t)
+{
+	double ms = t->ticks * 1000.0 / CLOCKS_PER_SEC;
+	double all = gen_stats.level.ticks * 1000.0 / CLOCKS_PER_SEC;
+
+	if (!t->calls) return;
+
+	file_putf(f, "%-24s %10u %8u %12.1f %10.3f %6.1f%%\n", name, t->calls,
+			  t->fails, ms, ms / t->calls, all > 0 ? 100 * ms / all : 0.0);
+}
+
+/**
+ * Write out the generation statistics as a table.
+ */
+void gen_stats_dump(ang_file *f)
+{
+	size_t i;
+
+	file_putf(f, "Levels made: %u in %u tries\n",
+			  gen_stats.level.calls - gen_stats.level.fails,
+			  gen_stats.level.calls);
+	file_putf(f, "find_space() guesses rejected: %u\n",
+			  gen_stats.space_misses);
+	file_putf(f, "Vaults with no space: %u\n\n", gen_stats.vault_fails);
+
+	file_putf(f, "%-24s %10s %8s %12s %10s %7s\n", "Phase", "Calls",
+			  "Fails", "Total ms", "Mean ms", "Share");
+	gen_timer_dump(f, "cave_generate() try", &gen_stats.level);
+	gen_timer_dump(f, "alloc_object()", &gen_stats.alloc);
+
+	file_putf(f, "\nProfiles:\n");
+	for (i = 0; i < N_ELEMENTS(cave_builders); i++)
+		gen_timer_dump(f, cave_builders[i].name, &profile_timers[i]);
+
+	file_putf(f, "\nRooms:\n");
+	for (i = 0; i < N_ELEMENTS(room_builders); i++)
+		gen_timer_dump(f, room_builders[i].name, &room_timers[i]);
+}
+
 /**
  * Generate a random level.
  *
@@ -860,6 +978,8 @@ void cave_generate(struct chunk **c, struct player *p)
 	/* Generate */
 	for (tries = 0; tries < 100 && error; tries++) {
 		struct dun_data dun_body;
+		clock_t try_start = gen_timer_start();
+		clock_t start;
 
 		error = NULL;
 
@@ -875,13 +995,18 @@ void cave_generate(struct chunk **c, struct player *p)
 
 		/* Choose a profile and build the level */
 		dun->profile = choose_profile(p->depth);
+		start = gen_timer_start();
 		chunk = dun->profile->builder(p);
+		if (gen_stats.on)
+			gen_timer_stop(gen_profile_timer(dun->profile->builder), start,
+						   chunk != NULL);
 		if (!chunk) {
 			error = "Failed to find builder";
 			mem_free(dun->cent);
 			mem_free(dun->door);
 			mem_free(dun->wall);
 			mem_free(dun->tunn);
+			gen_timer_stop(&gen_stats.level, try_start, FALSE);
 			continue;
 		}
 
@@ -906,10 +1031,10 @@ void cave_generate(struct chunk **c, struct player *p)
 		/* Clear generation flags. */
 		for (y = 0; y < chunk->height; y++) {
 			for (x = 0; x < chunk->width; x++) {
-				sqinfo_off(chunk->squares[y][x].info, SQUARE_WALL_INNER);
-				sqinfo_off(chunk->squares[y][x].info, SQUARE_WALL_OUTER);
-				sqinfo_off(chunk->squares[y][x].info, SQUARE_WALL_SOLID);
-				sqinfo_off(chunk->squares[y][x].info, SQUARE_MON_RESTRICT);
+				sqinfo_off(sq_info(chunk, y, x), SQUARE_WALL_INNER);
+				sqinfo_off(sq_info(chunk, y, x), SQUARE_WALL_OUTER);
+				sqinfo_off(sq_info(chunk, y, x), SQUARE_WALL_SOLID);
+				sqinfo_off(sq_info(chunk, y, x), SQUARE_MON_RESTRICT);
 			}
 		}
 
@@ -923,6 +1048,8 @@ void cave_generate(struct chunk **c, struct player *p)
 		mem_free(dun->door);
 		mem_free(dun->wall);
 		mem_free(dun->tunn);
+
+		gen_timer_stop(&gen_stats.level, try_start, error == NULL);
 	}
 
 	if (error) quit_fmt("cave_generate() failed 100 times!");
@@ -122,6 +122,9 @@ struct dun_data {
     /*!< Array of which blocks are used */
     bool **room_map;
 
+    /*!< Summed-area table of room_map, see room_map_used() */
+    int *room_sums;
+
     /*!< Number of pits/nests on the level */
     int pit_num;
 
@@ -237,10 +240,44 @@ typedef struct room_template {
     byte tval;			/*!< tval for objects in this room */
 } room_template_type;
 
+
+/**
+ * Time spent in, and counts for, one phase of level generation
+ */
+struct gen_timer {
+	u32b calls;			/*!< Number of times the phase was run */
+	u32b fails;			/*!< Number of those which failed */
+	long long ticks;	/*!< Total clock() ticks spent in it */
+};
+
+/**
+ * Level generation statistics, gathered while gen_stats.on is set, so that
+ * stats runs can see where generation spends its time.
+ */
+struct gen_stats {
+	bool on;					/*!< Whether to time generation */
+	struct gen_timer level;		/*!< Each try in cave_generate() */
+	struct gen_timer alloc;		/*!< Each alloc_object() */
+	struct gen_timer *profiles;	/*!< Each cave profile builder */
+	int n_profiles;
+	struct gen_timer *rooms;	/*!< Each room builder */
+	int n_rooms;
+	u32b space_misses;			/*!< Guesses rejected by find_space() */
+	u32b vault_fails;			/*!< Vaults with no space to go in */
+};
+
 struct dun_data *dun;
 struct vault *vaults;
 struct room_template *room_templates;
 
+/* generate.c */
+extern struct gen_stats gen_stats;
+clock_t gen_timer_start(void);
+void gen_timer_stop(struct gen_timer *t, clock_t start, bool ok);
+struct gen_timer *gen_room_timer(room_builder builder);
+void gen_stats_reset(void);
+void gen_stats_dump(ang_file *f);
+
 /* gen-cave.c */
 struct chunk *town_gen(struct player *p);
 struct chunk *classic_gen(struct player *p);
@@ -1341,6 +1341,8 @@ static errr finish_parse_object(struct parser *p) {
 static void cleanup_object(void)
 {
 	int idx;
+
+	object_names_cleanup();
 	for (idx = 0; idx < z_info->k_max; idx++) {
 		string_free(k_info[idx].name);
 		mem_free(k_info[idx].text);
@@ -1866,6 +1868,8 @@ static errr finish_parse_artifact(struct parser *p) {
 static void cleanup_artifact(void)
 {
 	int idx;
+
+	object_names_cleanup();
 	for (idx = 0; idx < z_info->a_max; idx++) {
 		string_free(a_info[idx].name);
 		mem_free(a_info[idx].alt_msg);
@@ -4372,6 +4376,7 @@ static struct init_module arrays_module = {
 
 
 extern struct init_module z_quark_module;
+extern struct init_module view_module;
 extern struct init_module generate_module;
 extern struct init_module obj_make_module;
 extern struct init_module ignore_module;
@@ -4387,6 +4392,7 @@ static struct init_module *modules[] = {
 	&messages_module,
 	&player_module,
 	&arrays_module,
+	&view_module,
 	&generate_module,
 	&obj_make_module,
 	&ignore_module,
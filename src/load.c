@@ -251,7 +251,8 @@ static struct object *rd_item(void)
 /**
  * Read a monster
  */
-static void rd_monster(struct chunk *c, monster_type *mon)
+static void rd_monster(struct chunk *c, monster_type *mon,
+					   struct monster_known_pstate *known)
 {
 	byte tmp8u;
 	u16b tmp16u;
@@ -281,10 +282,10 @@ static void rd_monster(struct chunk *c, monster_type *mon)
 		rd_byte(&mon->mflag[j]);
 
 	for (j = 0; j < of_size; j++)
-		rd_byte(&mon->known_pstate.flags[j]);
+		rd_byte(&known->flags[j]);
 
 	for (j = 0; j < elem_max; j++)
-		rd_s16b(&mon->known_pstate.el_info[j].res_level);
+		rd_s16b(&known->el_info[j].res_level);
 
 	rd_u16b(&tmp16u);
 
@@ -1064,7 +1065,7 @@ static int rd_dungeon_aux(struct chunk **c)
 	c1 = cave_new(height, width);
 	c1->name = string_make(name);
 
-    /* Run length decoding of cave->squares[y][x].info */
+    /* Run length decoding of the info plane */
 	for (n = 0; n < square_size; n++) {
 		/* Load the dungeon data */
 		for (x = y = 0; y < c1->height; ) {
@@ -1075,7 +1076,7 @@ static int rd_dungeon_aux(struct chunk **c)
 			/* Apply the RLE info */
 			for (i = count; i > 0; i--) {
 				/* Extract "info" */
-				c1->squares[y][x].info[n] = tmp8u;
+				sq_info(c1, y, x)[n] = tmp8u;
 
 				/* Advance/Wrap */
 				if (++x >= c1->width) {
@@ -1173,19 +1174,24 @@ static int rd_monsters_aux(struct chunk *c)
 	for (i = 1; i < limit; i++) {
 		monster_type *mon;
 		monster_type monster_type_body;
+		struct monster_known_pstate known;
 
 		/* Get local monster */
 		mon = &monster_type_body;
 		memset(mon, 0, sizeof(*mon));
+		memset(&known, 0, sizeof(known));
 
 		/* Read the monster */
-		rd_monster(c, mon);
+		rd_monster(c, mon, &known);
 
 		/* Place monster in dungeon */
 		if (place_monster(c, mon->fy, mon->fx, mon, 0) != i) {
 			note(format("Cannot place monster %d", i));
 			return (-1);
 		}
+
+		/* Restore what it knew */
+		memcpy(cave_monster_known(c, i), &known, sizeof(known));
 	}
 
 	return 0;
@@ -1212,8 +1218,8 @@ static int rd_traps_aux(struct chunk *c)
 			break;
 		else {
 			/* Put the trap at the front of the grid trap list */
-			trap->next = c->squares[y][x].trap;
-			c->squares[y][x].trap = trap;
+			trap->next = sq_trap(c, y, x);
+			sq_trap(c, y, x) = trap;
 		}
 	}
 
@@ -22,6 +22,7 @@
 
 #include "buildid.h"
 #include "game-world.h"
+#include "generate.h"
 #include "init.h"
 #include "main.h"
 #include "mon-make.h"
@@ -42,6 +43,9 @@
 #include "store.h"
 #include <stddef.h>
 #include <time.h>
+#ifdef UNIX
+#include <sys/wait.h>
+#endif
 
 #define OBJ_FEEL_MAX	 11
 #define MON_FEEL_MAX 	 10
@@ -66,6 +70,8 @@
 static int randarts = 0;
 static int no_selling = 0;
 static u32b num_runs = 1;
+static u32b num_jobs = 1;
+static u32b base_seed = 0;
 static bool quiet = FALSE;
 static int nextkey = 0;
 static int running_stats = 0;
@@ -213,16 +219,17 @@ static void generate_player_for_stats()
 	player->history = get_history(player->race->history);
 }
 
-static void initialize_character(void)
+/**
+ * Set up a new character, seeding the RNG with the run's own seed so that a
+ * run comes out the same whichever worker makes it.
+ */
+static void initialize_character(u32b seed)
 {
-	u32b seed;
-
 	if (!quiet) {
 		printf(" [I  ]\b\b\b\b\b\b");
 		fflush(stdout);
 	}
 
-	seed = (time(NULL));
 	Rand_quick = FALSE;
 	Rand_state_init(seed);
 
@@ -917,6 +924,11 @@ static int stats_dump_info(void)
 	err = stats_db_exec(sql_buf);
 	if (err) return err;
 
+	strnfmt(sql_buf, 256, "INSERT INTO metadata VALUES('seed',%u);",
+		base_seed);
+	err = stats_db_exec(sql_buf);
+	if (err) return err;
+
 	err = stats_dump_artifacts();
 	if (err) return err;
 
@@ -1487,10 +1499,316 @@ static void stats_cleanup_angband_run(void)
 	if (player->history) mem_free(player->history);
 }
 
+static artifact_type *a_info_save;
+
+/**
+ * Make one complete run through the dungeon.
+ */
+static void stats_run(u32b run)
+{
+	unsigned int i;
+
+	if (randarts)
+		for (i = 0; i < z_info->a_max; i++)
+			memcpy(&a_info[i], &a_info_save[i], sizeof(artifact_type));
+
+	initialize_character(base_seed + run);
+	unkill_uniques();
+	reset_artifacts();
+	descend_dungeon();
+	stats_cleanup_angband_run();
+}
+
+/**
+ * Report progress after the given number of runs.
+ */
+static void stats_progress(u32b run, time_t start)
+{
+	if (!quiet)
+		progress_bar(run, start);
+	else if (run % 1000 == 0) {
+		printf("Finished %d runs.\n", run);
+		fflush(stdout);
+	}
+}
+
+/**
+ * Checkpoint every so many runs, and after the last one.
+ */
+static void stats_checkpoint(u32b run)
+{
+	int err;
+
+	if (run % RUNS_PER_CHECKPOINT != 0) return;
+
+	err = stats_write_db(run);
+	if (err) {
+		stats_db_close();
+		quit_fmt("Problems writing to database!  sqlite3 errno %d.", err);
+	}
+}
+
+#ifdef UNIX
+
+/**
+ * ------------------------------------------------------------------------
+ * Parallel runs
+ *
+ * Level generation works on the one global cave, player and RNG, so runs
+ * are spread over worker processes rather than threads.  Each batch of runs
+ * up to a checkpoint is shared out between freshly forked workers; each
+ * worker counts its runs into its own copy of level_data and sends the
+ * counts back down a pipe, to be added to the totals.
+ * ------------------------------------------------------------------------ */
+
+typedef bool (*stats_block_func)(FILE *f, void *data, size_t num, size_t size);
+
+/**
+ * Zero a block, without touching the pages of blocks which are already
+ * zero (and so may still be shared with the parent).
+ */
+static bool stats_block_clear(FILE *f, void *data, size_t num, size_t size)
+{
+	const byte *p = data;
+	size_t i;
+
+	for (i = 0; i < num * size; i++) {
+		if (p[i]) {
+			memset(data, 0, num * size);
+			break;
+		}
+	}
+
+	return TRUE;
+}
+
+static bool stats_block_send(FILE *f, void *data, size_t num, size_t size)
+{
+	return fwrite(data, size, num, f) == num;
+}
+
+/**
+ * Read a block sent by a worker and add it to the totals.
+ */
+static bool stats_block_add(FILE *f, void *data, size_t num, size_t size)
+{
+	long long buf[256];
+	size_t i, done = 0;
+
+	while (done < num) {
+		size_t n = MIN(num - done, sizeof(buf) / size);
+
+		if (fread(buf, size, n, f) != n) return FALSE;
+
+		if (size == sizeof(long long))
+			for (i = 0; i < n; i++)
+				((long long *)data)[done + i] += buf[i];
+		else
+			for (i = 0; i < n; i++)
+				((u32b *)data)[done + i] += ((u32b *)buf)[i];
+
+		done += n;
+	}
+
+	return TRUE;
+}
+
+/**
+ * Apply func to each block of counts in level_data, in a fixed order.
+ */
+static bool stats_level_data_blocks(stats_block_func func, FILE *f)
+{
+	int i, j, k, l;
+
+	for (i = 0; i < LEVEL_MAX; i++) {
+		struct level_data *ld = &level_data[i];
+
+		if (!func(f, ld->monsters, z_info->r_max, sizeof(u32b)) ||
+			!func(f, ld->obj_feelings, OBJ_FEEL_MAX, sizeof(u32b)) ||
+			!func(f, ld->mon_feelings, MON_FEEL_MAX, sizeof(u32b)) ||
+			!func(f, ld->gold, ORIGIN_STATS, sizeof(long long)))
+			return FALSE;
+
+		for (j = 0; j < ORIGIN_STATS; j++) {
+			if (!func(f, ld->artifacts[j], z_info->a_max, sizeof(u32b)) ||
+				!func(f, ld->consumables[j], consumable_count + 1,
+					  sizeof(u32b)))
+				return FALSE;
+
+			for (k = 0; k < wearable_count + 1; k++) {
+				struct wearables_data *w = &ld->wearables[j][k];
+
+				if (!func(f, &w->count, 1, sizeof(u32b)) ||
+					!func(f, w->dice, TOP_DICE * TOP_SIDES, sizeof(u32b)) ||
+					!func(f, w->ac, TOP_AC, sizeof(u32b)) ||
+					!func(f, w->hit, TOP_PLUS, sizeof(u32b)) ||
+					!func(f, w->dam, TOP_PLUS, sizeof(u32b)) ||
+					!func(f, w->egos, z_info->e_max, sizeof(u32b)) ||
+					!func(f, w->flags, OF_MAX, sizeof(u32b)))
+					return FALSE;
+
+				for (l = 0; l < TOP_MOD; l++)
+					if (!func(f, w->modifiers[l], OBJ_MOD_MAX + 1,
+							  sizeof(u32b)))
+						return FALSE;
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+static bool stats_gen_timer_blocks(stats_block_func func, FILE *f,
+								   struct gen_timer *t)
+{
+	return func(f, &t->calls, 1, sizeof(u32b)) &&
+		func(f, &t->fails, 1, sizeof(u32b)) &&
+		func(f, &t->ticks, 1, sizeof(long long));
+}
+
+/**
+ * Apply func to each of the generation statistics, in a fixed order.
+ */
+static bool stats_gen_stats_blocks(stats_block_func func, FILE *f)
+{
+	int i;
+
+	if (!stats_gen_timer_blocks(func, f, &gen_stats.level) ||
+		!stats_gen_timer_blocks(func, f, &gen_stats.alloc))
+		return FALSE;
+
+	for (i = 0; i < gen_stats.n_profiles; i++)
+		if (!stats_gen_timer_blocks(func, f, &gen_stats.profiles[i]))
+			return FALSE;
+
+	for (i = 0; i < gen_stats.n_rooms; i++)
+		if (!stats_gen_timer_blocks(func, f, &gen_stats.rooms[i]))
+			return FALSE;
+
+	return func(f, &gen_stats.space_misses, 1, sizeof(u32b)) &&
+		func(f, &gen_stats.vault_fails, 1, sizeof(u32b));
+}
+
+/**
+ * Be one worker of a batch: make every num_jobs'th run from first to last,
+ * noting each run on the progress pipe, then send back the counts.
+ */
+static void stats_worker(u32b first, u32b last, int progress, int data)
+{
+	FILE *f = fdopen(data, "wb");
+	u32b run;
+
+	/* Count this batch only, and leave the output to the parent */
+	stats_level_data_blocks(stats_block_clear, NULL);
+	gen_stats_reset();
+	quiet = TRUE;
+
+	for (run = first; run <= last; run += num_jobs) {
+		stats_run(run);
+		if (write(progress, "r", 1) != 1) _exit(1);
+	}
+
+	/* The parent reads the counts only once every worker has let go of
+	 * the progress pipe, and they are far bigger than a pipe's buffer */
+	close(progress);
+
+	if (!f || !stats_level_data_blocks(stats_block_send, f) ||
+		!stats_gen_stats_blocks(stats_block_send, f) || fclose(f))
+		_exit(1);
+	_exit(0);
+}
+
+/**
+ * Make runs first to last across num_jobs workers, adding their counts to
+ * level_data.
+ */
+static void stats_run_batch(u32b first, u32b last, time_t start)
+{
+	pid_t *pids = mem_zalloc(num_jobs * sizeof(pid_t));
+	int *data = mem_zalloc(num_jobs * sizeof(int));
+	int progress[2];
+	u32b done = first - 1;
+	u32b i;
+	char buf[256];
+	ssize_t n;
+
+	if (pipe(progress)) quit("Couldn't create a pipe!");
+
+	for (i = 0; i < num_jobs; i++) {
+		int fds[2];
+
+		if (pipe(fds)) quit("Couldn't create a pipe!");
+
+		fflush(stdout);
+		pids[i] = fork();
+		if (pids[i] < 0) quit("Couldn't start a worker!");
+
+		if (pids[i] == 0) {
+			close(progress[0]);
+			close(fds[0]);
+			stats_worker(first + i, last, progress[1], fds[1]);
+		}
+
+		close(fds[1]);
+		data[i] = fds[0];
+	}
+	close(progress[1]);
+
+	/* Follow the runs as they finish */
+	while ((n = read(progress[0], buf, sizeof(buf))) != 0) {
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			break;
+		}
+		while (n--) stats_progress(++done, start);
+	}
+	close(progress[0]);
+
+	/* Collect the counts */
+	for (i = 0; i < num_jobs; i++) {
+		FILE *f = fdopen(data[i], "rb");
+		int status;
+
+		if (!f || !stats_level_data_blocks(stats_block_add, f) ||
+			!stats_gen_stats_blocks(stats_block_add, f))
+			quit("Couldn't read the results of a worker!");
+		fclose(f);
+
+		if (waitpid(pids[i], &status, 0) < 0 || !WIFEXITED(status) ||
+			WEXITSTATUS(status))
+			quit("A worker failed!");
+	}
+
+	mem_free(pids);
+	mem_free(data);
+}
+
+#endif /* UNIX */
+
+/**
+ * Write out where level generation spent its time.
+ */
+static void stats_dump_gen_timings(void)
+{
+	char buf[1024];
+	ang_file *f;
+
+	path_build(buf, sizeof(buf), ANGBAND_DIR_STATS, "gen-timings.txt");
+	f = file_open(buf, MODE_WRITE, FTYPE_TEXT);
+	if (!f) {
+		printf("Couldn't write %s\n", buf);
+		return;
+	}
+
+	gen_stats_dump(f);
+	file_close(f);
+
+	if (!quiet) printf("Generation timings written to %s\n", buf);
+}
+
 static errr run_stats(void)
 {
 	u32b run;
-	artifact_type *a_info_save;
 	unsigned int i;
 	int err;
 	bool status; 
@@ -1509,55 +1827,50 @@ static errr run_stats(void)
 		}
 	}
 
+	if (!base_seed) base_seed = time(NULL);
+	gen_stats_reset();
+	gen_stats.on = TRUE;
+
 	if (!quiet) printf("Creating the database and dumping info...\n");
 	status = stats_prep_db();
 	if (!status) quit("Couldn't prepare database!");
 
 	if (!quiet) {
 		printf("Beginning %d runs...\n", num_runs);
+		if (num_jobs > 1) printf("Using %d workers...\n", num_jobs);
 		fflush(stdout);
 	}
 
 	start = time(NULL);
-	for (run = 1; run <= num_runs; run++) {
-		if (!quiet) progress_bar(run - 1, start);
-
-		if (randarts)
-			for (i = 0; i < z_info->a_max; i++)
-				memcpy(&a_info[i], &a_info_save[i], sizeof(artifact_type));
-
-		initialize_character();
-		unkill_uniques();
-		reset_artifacts();
-		descend_dungeon();
-		stats_cleanup_angband_run();
-
-		/* Checkpoint every so many runs */
-		if (run % RUNS_PER_CHECKPOINT == 0) {
-			err = stats_write_db(run);
-			if (err) {
-				stats_db_close();
-				quit_fmt("Problems writing to database!  sqlite3 errno %d.",
-						 err);
-			}
-		}
+	if (!quiet) progress_bar(0, start);
+
+#ifdef UNIX
+	if (num_jobs > 1) {
+		for (run = 1; run <= num_runs; run += RUNS_PER_CHECKPOINT) {
+			u32b last = MIN(run + RUNS_PER_CHECKPOINT - 1, num_runs);
 
-		if (quiet && run % 1000 == 0) {
-			printf("Finished %d runs.\n", run);
-			fflush(stdout);
+			stats_run_batch(run, last, start);
+			stats_checkpoint(last);
 		}
+	} else
+#endif
+	for (run = 1; run <= num_runs; run++) {
+		stats_run(run);
+		stats_progress(run, start);
+		stats_checkpoint(run);
 	}
 
 	if (!quiet) {
-		progress_bar(num_runs, start);
 		printf("\nSaving the data...\n");
 		fflush(stdout);
 	}
 
-	err = stats_write_db(run);
+	err = stats_write_db(num_runs);
 	stats_db_close();
 	if (err) quit_fmt("Problems writing to database!  sqlite3 errno %d.", err);
 
+	stats_dump_gen_timings();
+
 	if (randarts)
 		mem_free(a_info_save);
 	free_stats_memory();
@@ -1689,17 +2002,19 @@ static void term_data_link(int i) {
 	angband_term[i] = t;
 }
 
-const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -s(no selling)";
+const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -s(no selling) -j(# of workers) -S(eed)";
 
 /**
  * Usage:
  *
- * angband -mstats -- [-q] [-r] [-nNNNN] [-s]
+ * angband -mstats -- [-q] [-r] [-nNNNN] [-s] [-jNN] [-SNNNN]
  *
  *   -q      Quiet mode (turn off progress messages)
  *   -r      Turn on randarts
  *   -nNNNN  Make NNNN runs through the dungeon (default: 1)
  *   -s      Turn on no-selling
+ *   -jNN    Share the runs between NN worker processes (default: 1)
+ *   -SNNNN  Seed run N with NNNN + N (default: the time)
  */
 
 errr init_stats(int argc, char *argv[]) {
@@ -1723,6 +2038,14 @@ errr init_stats(int argc, char *argv[]) {
 			no_selling = 1;
 			continue;
 		}
+		if (prefix(argv[i], "-j")) {
+			num_jobs = MAX(atoi(&argv[i][2]), 1);
+			continue;
+		}
+		if (prefix(argv[i], "-S")) {
+			base_seed = strtoul(&argv[i][2], NULL, 10);
+			continue;
+		}
 		printf("init-stats: bad argument '%s'\n", argv[i]);
 	}
 
@@ -90,24 +90,26 @@ static void remove_bad_spells(struct monster *m_ptr, bitflag f[RSF_SIZE])
 	of_wipe(ai_flags);
 	pf_wipe(ai_pflags);
 	if (OPT(birth_ai_learn)) {
+		struct monster_known_pstate *known =
+			cave_monster_known(cave, m_ptr->midx);
 		size_t i;
 
 		/* Occasionally forget player status */
 		if (one_in_(100)) {
-			of_wipe(m_ptr->known_pstate.flags);
-			pf_wipe(m_ptr->known_pstate.pflags);
+			of_wipe(known->flags);
+			pf_wipe(known->pflags);
 			for (i = 0; i < ELEM_MAX; i++)
-				m_ptr->known_pstate.el_info[i].res_level = 0;
+				known->el_info[i].res_level = 0;
 		}
 
 		/* Use the memorized info */
-		of_copy(ai_flags, m_ptr->known_pstate.flags);
-		of_copy(ai_pflags, m_ptr->known_pstate.pflags);
+		of_copy(ai_flags, known->flags);
+		of_copy(ai_pflags, known->pflags);
 		if (!of_is_empty(ai_flags) || !pf_is_empty(ai_pflags))
 			know_something = TRUE;
 
 		for (i = 0; i < ELEM_MAX; i++) {
-			el[i].res_level = m_ptr->known_pstate.el_info[i].res_level;
+			el[i].res_level = known->el_info[i].res_level;
 			if (el[i].res_level != 0)
 				know_something = TRUE;
 		}
@@ -447,6 +447,7 @@ static void cleanup_mon_base(void)
 {
 	struct monster_base *rb, *next;
 
+	monster_names_cleanup();
 	rb = rb_info;
 	while (rb) {
 		next = rb->next;
@@ -954,6 +955,8 @@ static void cleanup_monster(void)
 {
 	int ridx;
 
+	monster_names_cleanup();
+
 	for (ridx = 0; ridx < z_info->r_max; ridx++) {
 		struct monster_race *r = &r_info[ridx];
 		struct monster_drop *d;
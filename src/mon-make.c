@@ -40,6 +40,48 @@ s16b num_repro;
 static s16b alloc_race_size;
 static struct alloc_entry *alloc_race_table;
 
+/**
+ * A filtered view of the monster allocation table.
+ *
+ * Each view holds the probability of every table entry under one restriction
+ * (a get_mon_num_prep() hook, and the key its answer depends on), and running
+ * totals of the probabilities of the races get_mon_num() may pick for a
+ * level, so picking is a binary search.  The totals also depend on the
+ * level, the player's depth and the season, and are rebuilt when any of
+ * those changes.  Uniques which are already at their limit are not left out
+ * of the totals, as their counts change all the time; instead a pick which
+ * lands on one falls back to exact totals, built just for that call.
+ */
+struct mon_alloc_view {
+	bool (*hook)(struct monster_race *race);
+	const void *key;
+	u32b used;			/* When the view was last chosen */
+	s16b *prob;			/* Probability of each table entry */
+
+	bool valid;			/* The totals match the probabilities */
+	int level;			/* Level the totals are for */
+	int depth;			/* Player depth the totals are for */
+	bool christmas;		/* Whether seasonal monsters are allowed */
+	int n;				/* Number of table entries the totals cover */
+	long total;			/* Sum of all allowed probabilities */
+	long *sums;			/* Running totals, one per table entry */
+	long *exact;		/* Running totals leaving out unavailable uniques */
+};
+
+/**
+ * The first view is unrestricted, the second is for hooks which can't be
+ * cached, and the rest are kept for get_mon_num_prep_cached(), the least
+ * recently used being reused when they run out
+ */
+#define MON_ALLOC_VIEWS		32
+static struct mon_alloc_view mon_alloc_views[MON_ALLOC_VIEWS];
+static u32b mon_alloc_clock;
+
+/**
+ * The view get_mon_num() picks from
+ */
+static struct mon_alloc_view *mon_alloc;
+
 static void init_race_allocs(void) {
 	int i;
 	struct monster_race *race;
@@ -117,9 +159,22 @@ static void init_race_allocs(void) {
 	}
 	mem_free(aux);
 	mem_free(num);
+
+	/* Start unrestricted */
+	get_mon_num_prep(NULL);
 }
 
 static void cleanup_race_allocs(void) {
+	int i;
+
+	for (i = 0; i < MON_ALLOC_VIEWS; i++) {
+		mem_free(mon_alloc_views[i].prob);
+		mem_free(mon_alloc_views[i].sums);
+		mem_free(mon_alloc_views[i].exact);
+	}
+	memset(mon_alloc_views, 0, sizeof(mon_alloc_views));
+	mon_alloc = NULL;
+
 	mem_free(alloc_race_table);
 }
 
@@ -157,7 +212,11 @@ void delete_monster_idx(int m_idx)
 	monmem_remove(player->upkeep, mon);
 	
 	/* Monster is gone */
-	cave->squares[y][x].mon = 0;
+	cave_monster_index_remove(cave, m_idx);
+	cave_light_unregister(cave, m_idx);
+	cave_monster_sched_remove(cave, m_idx);
+	cave_monster_forget_park(cave, m_idx);
+	sq_mon(cave, y, x) = 0;
 
 	/* Delete objects */
 	obj = mon->held_obj;
@@ -184,6 +243,9 @@ void delete_monster_idx(int m_idx)
 	/* Wipe the Monster */
 	memset(mon, 0, sizeof(struct monster));
 
+	/* The hole can be reused */
+	cave->mon_free[cave->mon_free_n++] = m_idx;
+
 	/* Count monsters */
 	cave->mon_cnt--;
 
@@ -200,56 +262,63 @@ void delete_monster(int y, int x)
 	assert(square_in_bounds(cave, y, x));
 
 	/* Delete the monster (if any) */
-	if (cave->squares[y][x].mon > 0)
-		delete_monster_idx(cave->squares[y][x].mon);
+	if (sq_mon(cave, y, x) > 0)
+		delete_monster_idx(sq_mon(cave, y, x));
 }
 
 
 /**
- * Move a monster from index i1 to index i2 in the monster list.
+ * Close up the holes in the monster list in one pass, keeping the monsters
+ * in order, and fix everything that refers to a monster by index or pointer.
  */
-static void compact_monsters_aux(int i1, int i2)
+static void compact_monsters_excise(struct chunk *c)
 {
-	int y, x;
-	struct monster *mon;
-	struct object *obj;
+	struct monster *target = target_get_monster();
+	struct monster *health = player->upkeep->health_who;
+	int from, to;
 
-	/* Do nothing */
-	if (i1 == i2) return;
-
-	/* Old monster */
-	mon = cave_monster(cave, i1);
-	y = mon->fy;
-	x = mon->fx;
-
-	/* Update the cave */
-	cave->squares[y][x].mon = i2;
-	
-	/* Update midx */
-	mon->midx = i2;
-
-	/* Repair objects being carried by monster */
-	for (obj = mon->held_obj; obj; obj = obj->next)
-		obj->held_m_idx = i2;
+	for (from = 1, to = 1; from < cave_monster_max(c); from++) {
+		struct monster *mon = cave_monster(c, from);
+		struct monster *dest = cave_monster(c, to);
+		struct object *obj;
 
-	/* Move mimicked objects (heh) */
-	if (mon->mimicked_obj)
-		mon->mimicked_obj->mimicking_m_idx = i2;
+		/* Skip holes */
+		if (!mon->race) continue;
 
-	/* Hack -- Update the target */
-	if (target_get_monster() == mon)
-		target_set_monster(cave_monster(cave, i2));
+		if (from != to) {
+			/* Move the monster and what the chunk keeps for it */
+			memcpy(dest, mon, sizeof(struct monster));
+			memcpy(cave_monster_known(c, to), cave_monster_known(c, from),
+				   sizeof(struct monster_known_pstate));
+			c->mon_handled[to] = c->mon_handled[from];
+			c->dormant_slot[to] = c->dormant_slot[from];
+			c->dormant_turn[to] = c->dormant_turn[from];
+			c->dormant_slot[from] = 0;
+			memset(mon, 0, sizeof(struct monster));
+
+			/* Repoint the grid and the objects */
+			dest->midx = to;
+			sq_mon(c, dest->fy, dest->fx) = to;
+			for (obj = dest->held_obj; obj; obj = obj->next)
+				obj->held_m_idx = to;
+			if (dest->mimicked_obj)
+				dest->mimicked_obj->mimicking_m_idx = to;
+
+			/* Repoint the trackers */
+			if (target == mon)
+				target_set_monster(dest);
+			if (health == mon)
+				player->upkeep->health_who = dest;
+		}
 
-	/* Hack -- Update the health bar */
-	if (player->upkeep->health_who == mon)
-		player->upkeep->health_who = cave_monster(cave, i2);
+		to++;
+	}
 
-	/* Hack -- move monster */
-	memcpy(cave_monster(cave, i2), cave_monster(cave, i1),
-		   sizeof(struct monster));
+	/* Shrink the list, and there are no holes left */
+	c->mon_max = to;
+	c->mon_free_n = 0;
 
-	/* Hack -- wipe hole */
-	memset(cave_monster(cave, i1), 0, sizeof(struct monster));
+	cave_monster_reindex(c);
 }
 
 
@@ -274,10 +343,12 @@ void compact_monsters(int num_to_compact)
 	int max_lev, min_dis, chance;
 
 
-	/* Message (only if compacting) */
-	if (num_to_compact)
-		msg("Compacting monsters...");
+	/* Parked monsters need their true energy and distances, both here and
+	 * when saving (which compacts nothing) */
+	cave_monster_unpark_all(cave);
 
+	/* Message (only if compacting) */
+	if (num_to_compact) msg("Compacting monsters...");
 
 	/* Compact at least 'num_to_compact' objects */
 	for (num_compacted = 0, iter = 1; num_compacted < num_to_compact; iter++) {
@@ -322,19 +393,8 @@ void compact_monsters(int num_to_compact)
 	}
 
 
-	/* Excise dead monsters (backwards!) */
-	for (m_idx = cave_monster_max(cave) - 1; m_idx >= 1; m_idx--) {
-		struct monster *mon = cave_monster(cave, m_idx);
-
-		/* Skip real monsters */
-		if (mon->race) continue;
-
-		/* Move last monster into open hole */
-		compact_monsters_aux(cave_monster_max(cave) - 1, m_idx);
-
-		/* Compress "cave->mon_max" */
-		cave->mon_max--;
-	}
+	/* Excise dead monsters */
+	compact_monsters_excise(cave);
 }
 
 
@@ -365,7 +425,11 @@ void wipe_mon_list(struct chunk *c, struct player *p)
 		mon->race->cur_num--;
 
 		/* Monster is gone */
-		c->squares[mon->fy][mon->fx].mon = 0;
+		cave_monster_index_remove(c, m_idx);
+		cave_light_unregister(c, m_idx);
+		cave_monster_sched_remove(c, m_idx);
+		cave_monster_forget_park(c, m_idx);
+		sq_mon(c, mon->fy, mon->fx) = 0;
 
 		/* Wipe the Monster */
 		memset(mon, 0, sizeof(struct monster));
@@ -373,6 +437,7 @@ void wipe_mon_list(struct chunk *c, struct player *p)
 
 	/* Reset "cave->mon_max" */
 	c->mon_max = 1;
+	c->mon_free_n = 0;
 
 	/* Reset "mon_cnt" */
 	c->mon_cnt = 0;
@@ -397,6 +462,20 @@ s16b mon_pop(struct chunk *c)
 {
 	int m_idx;
 
+	/* Reuse a hole left by a dead monster */
+	while (c->mon_free_n) {
+		m_idx = c->mon_free[--c->mon_free_n];
+
+		/* Holes past the end went with the last compaction */
+		if (m_idx >= cave_monster_max(c) || cave_monster(c, m_idx)->race)
+			continue;
+
+		/* Count monsters */
+		c->mon_cnt++;
+
+		return m_idx;
+	}
+
 	/* Normal allocation */
 	if (cave_monster_max(c) < z_info->level_monster_max) {
 		/* Get the next hole */
@@ -437,63 +516,232 @@ s16b mon_pop(struct chunk *c)
 
 
 /**
- * Apply a "monster restriction function" to the "monster allocation table".
- * This way, we can use get_mon_num() to get a level-appropriate monster that
- * satisfies certain conditions (such as belonging to a particular monster
- * family).
+ * Fill in the probabilities of a view of the allocation table
  */
-void get_mon_num_prep(bool (*get_mon_num_hook)(struct monster_race *race))
+static void mon_alloc_view_fill(struct mon_alloc_view *view,
+								bool (*hook)(struct monster_race *race),
+								const void *key)
 {
 	int i;
 
+	if (!view->prob) {
+		view->prob = mem_zalloc(alloc_race_size * sizeof(s16b));
+		view->sums = mem_zalloc(alloc_race_size * sizeof(long));
+		view->exact = mem_zalloc(alloc_race_size * sizeof(long));
+	}
+
+	view->hook = hook;
+	view->key = key;
+
 	/* Scan the allocation table */
 	for (i = 0; i < alloc_race_size; i++) {
 		alloc_entry *entry = &alloc_race_table[i];
 
 		/* Accept monsters which pass the restriction, if any */
-		if (!get_mon_num_hook || (*get_mon_num_hook)(&r_info[entry->index]))
-			entry->prob2 = entry->prob1;
+		if (!hook || (*hook)(&r_info[entry->index]))
+			view->prob[i] = entry->prob1;
 
 		/* Do not use this monster */
 		else
-			entry->prob2 = 0;
+			view->prob[i] = 0;
+	}
+
+	/* The totals are out of date */
+	view->valid = FALSE;
+}
+
+/**
+ * Apply a "monster restriction function" to the "monster allocation table".
+ * This way, we can use get_mon_num() to get a level-appropriate monster that
+ * satisfies certain conditions (such as belonging to a particular monster
+ * family).
+ *
+ * The hook is run over the whole table on every call; restrictions which
+ * depend only on a fixed key should use get_mon_num_prep_cached() instead.
+ */
+void get_mon_num_prep(bool (*get_mon_num_hook)(struct monster_race *race))
+{
+	/* The unrestricted view never changes */
+	if (!get_mon_num_hook) {
+		mon_alloc = &mon_alloc_views[0];
+		if (!mon_alloc->prob)
+			mon_alloc_view_fill(mon_alloc, NULL, NULL);
+		return;
+	}
+
+	mon_alloc = &mon_alloc_views[1];
+	mon_alloc_view_fill(mon_alloc, get_mon_num_hook, NULL);
+}
+
+/**
+ * Like get_mon_num_prep(), for a hook whose answer for each race depends
+ * only on `key` (a pit profile, summon type or monster base, for example).
+ *
+ * The filtered views are remembered, so going back to a restriction used
+ * recently costs nothing.
+ */
+void get_mon_num_prep_cached(bool (*get_mon_num_hook)(struct monster_race *race),
+							 const void *key)
+{
+	int i;
+	struct mon_alloc_view *view = NULL;
+
+	if (!get_mon_num_hook) {
+		get_mon_num_prep(NULL);
+		return;
+	}
+
+	/* Look for the view, and the oldest (or an empty) one just in case */
+	for (i = 2; i < MON_ALLOC_VIEWS; i++) {
+		struct mon_alloc_view *try = &mon_alloc_views[i];
+
+		if (try->prob && try->hook == get_mon_num_hook && try->key == key) {
+			view = try;
+			break;
+		}
+
+		if (!view || try->used < view->used)
+			view = try;
 	}
 
-	return;
+	/* Make the view if it wasn't there */
+	if (!view->prob || view->hook != get_mon_num_hook || view->key != key)
+		mon_alloc_view_fill(view, get_mon_num_hook, key);
+
+	view->used = ++mon_alloc_clock;
+	mon_alloc = view;
 }
 
 /**
- * Helper function for get_mon_num(). Scans the prepared monster allocation
- * table and picks a random monster. Returns the index of a monster in
- * `table`.
+ * Whether a unique is at its limit
  */
-static struct monster_race *get_mon_race_aux(long total,
-											 const alloc_entry *table)
+static bool mon_alloc_unavailable(const struct monster_race *race)
+{
+	return rf_has(race->flags, RF_UNIQUE) && race->cur_num >= race->max_num;
+}
+
+/**
+ * Fill `sums` with the running totals of the probabilities of the races
+ * allowed at `level`, leaving out uniques at their limit if `exact` is set.
+ * Returns the grand total.
+ */
+static long mon_alloc_build(int level, long *sums, bool exact)
 {
 	int i;
+	long total = 0L;
+
+	for (i = 0; i < mon_alloc->n; i++) {
+		const alloc_entry *entry = &alloc_race_table[i];
+		const struct monster_race *race = &r_info[entry->index];
+		bool allowed = TRUE;
+
+		/* No town monsters in dungeon */
+		if ((level > 0) && (entry->level <= 0))
+			allowed = FALSE;
+
+		/* No seasonal monsters outside of Christmas */
+		else if (rf_has(race->flags, RF_SEASONAL) && !mon_alloc->christmas)
+			allowed = FALSE;
+
+		/* Some monsters never appear out of depth */
+		else if (rf_has(race->flags, RF_FORCE_DEPTH) &&
+				 race->level > mon_alloc->depth)
+			allowed = FALSE;
+
+		/* Only one copy of a a unique must be around at the same time */
+		else if (exact && mon_alloc_unavailable(race))
+			allowed = FALSE;
+
+		if (allowed)
+			total += mon_alloc->prob[i];
+		sums[i] = total;
+	}
+
+	return total;
+}
+
+/**
+ * Make the allocation totals fit `level`
+ */
+static void mon_alloc_prepare(int level)
+{
+	time_t cur_time;
+	struct tm *date;
+
+	if (mon_alloc->valid && mon_alloc->level == level &&
+		mon_alloc->depth == player->depth)
+		return;
+
+	/* Look up the date once for the whole table */
+	cur_time = time(NULL);
+	date = localtime(&cur_time);
+	mon_alloc->christmas = date->tm_mon == 11 && date->tm_mday >= 24 &&
+		date->tm_mday <= 26;
+
+	mon_alloc->level = level;
+	mon_alloc->depth = player->depth;
+
+	/* Monsters are sorted by depth */
+	for (mon_alloc->n = 0; mon_alloc->n < alloc_race_size; mon_alloc->n++)
+		if (alloc_race_table[mon_alloc->n].level > level) break;
+
+	mon_alloc->total = mon_alloc_build(level, mon_alloc->sums, FALSE);
+	mon_alloc->valid = TRUE;
+}
+
+/**
+ * Helper function for get_mon_num(). Picks a random monster race using the
+ * running totals in `sums`, which add up to `total`.
+ */
+static struct monster_race *get_mon_race_aux(long total, const long *sums)
+{
+	int lo = 0, hi = mon_alloc->n - 1;
 
 	/* Pick a monster */
 	long value = randint0(total);
 
-	/* Find the monster */
-	for (i = 0; i < alloc_race_size; i++) {
-		/* Found the entry */
-		if (value < table[i].prob3) break;
-
-		/* Decrement */
-		value -= table[i].prob3;
+	/* Find the first entry whose running total is past the value */
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (sums[mid] > value)
+			hi = mid;
+		else
+			lo = mid + 1;
 	}
-	
-	return &r_info[table[i].index];
+
+	return &r_info[alloc_race_table[lo].index];
+}
+
+/**
+ * Helper function for get_mon_num(). Picks a random monster race which is
+ * allowed at `level`, switching `*sums` and `*total` to exact totals if the
+ * cached ones turn up a unique at its limit.
+ *
+ * A pick thrown away like that and made again from the exact totals comes
+ * out with just the same odds as a pick from the exact totals alone.
+ */
+static struct monster_race *get_mon_race_pick(int level, const long **sums,
+											  long *total)
+{
+	struct monster_race *race = get_mon_race_aux(*total, *sums);
+
+	if ((*sums == mon_alloc->exact) || !mon_alloc_unavailable(race))
+		return race;
+
+	*sums = mon_alloc->exact;
+	*total = mon_alloc_build(level, mon_alloc->exact, TRUE);
+	if (*total <= 0) return NULL;
+
+	return get_mon_race_aux(*total, *sums);
 }
 
 /**
  * Chooses a monster race that seems "appropriate" to the given level
  *
- * This function uses the "prob2" field of the "monster allocation table",
- * and various local information, to calculate the "prob3" field of the
- * same table, which is then used to choose an "appropriate" monster, in
- * a relatively efficient manner.
+ * This function uses the view of the "monster allocation table" chosen by
+ * get_mon_num_prep(), and various local information, to keep the running
+ * totals in that view, which are then used to choose an "appropriate"
+ * monster, in a relatively efficient manner.
  *
  * Note that "town" monsters will *only* be created in the town, and
  * "normal" monsters will *never* be created in the town, unless the
@@ -511,63 +759,28 @@ static struct monster_race *get_mon_race_aux(long total,
  */
 struct monster_race *get_mon_num(int level)
 {
-	int i, p;
+	int p;
 
 	long total;
+	const long *sums;
 
 	struct monster_race *race;
 
-	alloc_entry *table = alloc_race_table;
-
 	/* Occasionally produce a nastier monster in the dungeon */
 	if (level > 0 && one_in_(z_info->ood_monster_chance))
 		level += MIN(level / 4 + 2, z_info->ood_monster_amount);
 
-	total = 0L;
-
-	/* Process probabilities */
-	for (i = 0; i < alloc_race_size; i++) {
-		time_t cur_time = time(NULL);
-		struct tm *date = localtime(&cur_time);
-
-		/* Monsters are sorted by depth */
-		if (table[i].level > level) break;
-
-		/* Default */
-		table[i].prob3 = 0;
-
-		/* No town monsters in dungeon */
-		if ((level > 0) && (table[i].level <= 0)) continue;
-
-		/* Get the chosen monster */
-		race = &r_info[table[i].index];
-
-		/* No seasonal monsters outside of Christmas */
-		if (rf_has(race->flags, RF_SEASONAL) && 
-			!(date->tm_mon == 11 && date->tm_mday >= 24 && date->tm_mday <= 26))
-			continue;
-
-		/* Only one copy of a a unique must be around at the same time */
-		if (rf_has(race->flags, RF_UNIQUE) && 
-				race->cur_num >= race->max_num)
-			continue;
-
-		/* Some monsters never appear out of depth */
-		if (rf_has(race->flags, RF_FORCE_DEPTH) && race->level > player->depth)
-			continue;
-
-		/* Accept */
-		table[i].prob3 = table[i].prob2;
-
-		/* Total */
-		total += table[i].prob3;
-	}
+	/* Get the running totals for this level */
+	mon_alloc_prepare(level);
+	sums = mon_alloc->sums;
+	total = mon_alloc->total;
 
 	/* No legal monsters */
 	if (total <= 0) return NULL;
 
 	/* Pick a monster */
-	race = get_mon_race_aux(total, table);
+	race = get_mon_race_pick(level, &sums, &total);
+	if (!race) return NULL;
 
 	/* Try for a "harder" monster once (50%) or twice (10%) */
 	p = randint0(100);
@@ -576,7 +789,7 @@ struct monster_race *get_mon_num(int level)
 		struct monster_race *old = race;
 
 		/* Pick a new monster */
-		race = get_mon_race_aux(total, table);
+		race = get_mon_race_pick(level, &sums, &total);
 
 		/* Keep the deepest one */
 		if (race->level < old->level) race = old;
@@ -587,7 +800,7 @@ struct monster_race *get_mon_num(int level)
 		struct monster_race *old = race;
 
 		/* Pick a monster */
-		race = get_mon_race_aux(total, table);
+		race = get_mon_race_pick(level, &sums, &total);
 
 		/* Keep the deepest one */
 		if (race->level < old->level) race = old;
@@ -768,11 +981,18 @@ s16b place_monster(struct chunk *c, int y, int x, struct monster *mon,
 	/* Set the ID */
 	new_mon->midx = m_idx;
 
+	/* New monsters know nothing of the player */
+	memset(cave_monster_known(c, m_idx), 0,
+		   sizeof(struct monster_known_pstate));
+
 	/* Set the location */
-	c->squares[y][x].mon = new_mon->midx;
+	sq_mon(c, y, x) = new_mon->midx;
 	new_mon->fy = y;
 	new_mon->fx = x;
 	assert(square_monster(c, y, x) == new_mon);
+	cave_monster_index_add(c, m_idx);
+	cave_light_register(c, m_idx);
+	cave_monster_sched_add(c, m_idx);
 
 	update_mon(new_mon, c, TRUE);
 
@@ -1193,7 +1413,7 @@ bool place_new_monster(struct chunk *c, int y, int x, struct monster_race *race,
 		place_monster_base = friends_base->base;
 
 		/* Prepare allocation table */
-		get_mon_num_prep(place_monster_base_okay);
+		get_mon_num_prep_cached(place_monster_base_okay, place_monster_base);
 
 		/* Pick a random race */
 		friends_race = get_mon_num(race->level);
@@ -1388,6 +1608,8 @@ bool mon_take_hit(struct monster *mon, int dam, bool *fear, const char *note)
 	s32b div, new_exp, new_exp_frac;
 	monster_lore *l_ptr = get_lore(mon->race);
 
+	/* Hurt monsters are never parked */
+	cave_monster_unpark(cave, mon->midx);
 
 	/* Redraw (later) if needed */
 	if (player->upkeep->health_who == mon)
@@ -27,6 +27,8 @@ void compact_monsters(int num_to_compact);
 void wipe_mon_list(struct chunk *c, struct player *p);
 s16b mon_pop(struct chunk *c);
 void get_mon_num_prep(bool (*get_mon_num_hook)(monster_race *race));
+void get_mon_num_prep_cached(bool (*get_mon_num_hook)(monster_race *race),
+							 const void *key);
 monster_race *get_mon_num(int level);
 s16b place_monster(struct chunk *c, int y, int x, struct monster *mon,
 				   byte origin);
@@ -24,6 +24,7 @@
 
 #include "angband.h"
 #include "cave.h"
+#include "game-input.h"
 #include "game-world.h"
 #include "init.h"
 #include "monster.h"
@@ -176,34 +177,45 @@ static void find_range(monster_type *mon)
  *
  * Note that "reproduction" REQUIRES empty space.
  *
+ * The offspring goes in one of the grids next to the parent, found in up to
+ * 18 tries which each pick any grid of the 3x3 block in bounds (as scatter()
+ * would).  The free grids are found once, and each try is a single random
+ * pick, with the same odds as trying grids one at a time.
+ *
  * Returns TRUE if the monster successfully reproduced.
  */
 bool multiply_monster(const monster_type *mon)
 {
+	struct loc sites[9];
 	int i, y, x;
+	int grids = 0, room = 0;
 
-	bool result = FALSE;
+	/* Find the free grids around the parent, and count them all */
+	for (y = mon->fy - 1; y <= mon->fy + 1; y++) {
+		for (x = mon->fx - 1; x <= mon->fx + 1; x++) {
+			if (!square_in_bounds_fully(cave, y, x)) continue;
+			grids++;
 
-	/* Try up to 18 times */
-	for (i = 0; i < 18; i++) {
-		int d = 1;
+			/* Require an "empty" floor grid */
+			if (square_isempty(cave, y, x))
+				sites[room++] = loc(x, y);
+		}
+	}
 
-		/* Pick a location */
-		scatter(cave, &y, &x, mon->fy, mon->fx, d, TRUE);
+	/* No room */
+	if (!room) return FALSE;
 
-		/* Require an "empty" floor grid */
-		if (!square_isempty(cave, y, x)) continue;
+	/* Try up to 18 times; free grids are the first picks */
+	for (i = 0; i < 18; i++) {
+		int pick = randint0(grids);
+		if (pick >= room) continue;
 
 		/* Create a new monster (awake, no groups) */
-		result = place_new_monster(cave, y, x, mon->race, FALSE, FALSE,
-			ORIGIN_DROP_BREED);
-
-		/* Done */
-		break;
+		return place_new_monster(cave, sites[pick].y, sites[pick].x,
+								 mon->race, FALSE, FALSE, ORIGIN_DROP_BREED);
 	}
 
-	/* Result */
-	return (result);
+	return FALSE;
 }
 
 
@@ -245,7 +257,7 @@ static bool near_permwall(const monster_type *mon, struct chunk *c)
  * through obstacles.
  *
  * Monsters first try to use up-to-date distance information ('sound') as
- * saved in cave->squares[y][x].cost.  Failing that, they'll try using scent
+ * saved in sq_cost(cave, y, x).  Failing that, they'll try using scent
  * ('when') which is just old cost information.
  *
  * Tracking by 'scent' means that monsters end up near enough the player to
@@ -267,20 +279,39 @@ static bool get_moves_flow(struct chunk *c, struct monster *mon)
 	int py = player->py, px = player->px;
 	int my = mon->fy, mx = mon->fx;
 
-	/* Only use this algorithm for passwall monsters if near permanent walls,
-	 * to avoid getting snagged */
+	/* Only flow passwall monsters if near permanent walls, to avoid getting
+	 * snagged, and then route them around only the permanent walls */
 	if (flags_test(mon->race->flags, RF_SIZE, RF_PASS_WALL, RF_KILL_WALL,
-				   FLAG_END) && !near_permwall(mon, c))
-		return (FALSE);
+				   FLAG_END)) {
+		s16b *dist;
+		int y, x;
+
+		if (!near_permwall(mon, c))
+			return (FALSE);
+
+		/* Monster is too far away to notice the player */
+		dist = cave_flow(c, FLOW_PASSWALL);
+		if (dist[square_idx(c, my, mx)] > mon->race->aaf) return FALSE;
+
+		/* If the player can see monster, run towards them */
+		if (square_isview(c, my, mx)) return FALSE;
+
+		/* Step towards the player */
+		if (!cave_flow_downhill(c, FLOW_PASSWALL, my, mx, &y, &x))
+			return FALSE;
+		mon->ty = y;
+		mon->tx = x;
+		return TRUE;
+	}
 
 	/* The player is not currently near the monster grid */
-	if (c->squares[my][mx].when < c->squares[py][px].when)
+	if (sq_when(c, my, mx) < sq_when(c, py, px))
 		/* If the player has never been near this grid, abort */
-		if (c->squares[my][mx].when == 0) return FALSE;
+		if (sq_when(c, my, mx) == 0) return FALSE;
 
 	/* Monster is too far away to notice the player */
-	if (c->squares[my][mx].cost > z_info->max_flow_depth) return FALSE;
-	if (c->squares[my][mx].cost > mon->race->aaf) return FALSE;
+	if (sq_cost(c, my, mx) > z_info->max_flow_depth) return FALSE;
+	if (sq_cost(c, my, mx) > mon->race->aaf) return FALSE;
 	/* If the player can see monster, run towards them */
 	if (square_isview(c, my, mx)) return FALSE;
 
@@ -292,17 +323,17 @@ static bool get_moves_flow(struct chunk *c, struct monster *mon)
 		int x = mx + ddx_ddd[i];
 
 		/* Ignore unvisited/unpassable locations */
-		if (c->squares[y][x].when == 0) continue;
+		if (sq_when(c, y, x) == 0) continue;
 
 		/* Ignore locations whose data is more stale */
-		if (c->squares[y][x].when < best_when) continue;
+		if (sq_when(c, y, x) < best_when) continue;
 
 		/* Ignore locations which are farther away */
-		if (c->squares[y][x].cost > best_cost) continue;
+		if (sq_cost(c, y, x) > best_cost) continue;
 
 		/* Save the cost and time */
-		best_when = c->squares[y][x].when;
-		best_cost = c->squares[y][x].cost;
+		best_when = sq_when(c, y, x);
+		best_cost = sq_cost(c, y, x);
 		best_direction = i;
 		found_direction = TRUE;
 	}
@@ -345,12 +376,12 @@ static bool get_moves_fear(struct chunk *c, struct monster *mon)
 	int my = mon->fy, mx = mon->fx;
 
 	/* If the player is not currently near the monster, no reason to flow */
-	if (c->squares[my][mx].when < c->squares[py][px].when)
+	if (sq_when(c, my, mx) < sq_when(c, py, px))
 		return FALSE;
 
 	/* Monster is too far away to use flow information */
-	if (c->squares[my][mx].cost > z_info->max_flow_depth) return FALSE;
-	if (c->squares[my][mx].cost > mon->race->aaf) return FALSE;
+	if (sq_cost(c, my, mx) > z_info->max_flow_depth) return FALSE;
+	if (sq_cost(c, my, mx) > mon->race->aaf) return FALSE;
 
 	/* Check nearby grids, diagonals first */
 	for (i = 7; i >= 0; i--) {
@@ -361,7 +392,7 @@ static bool get_moves_fear(struct chunk *c, struct monster *mon)
 		int x = mx + ddx_ddd[i];
 
 		/* Ignore illegal & older locations */
-		if (c->squares[y][x].when == 0 || c->squares[y][x].when < best_when)
+		if (sq_when(c, y, x) == 0 || sq_when(c, y, x) < best_when)
 			continue;
 
 		/* Calculate distance of this grid from our target */
@@ -371,7 +402,7 @@ static bool get_moves_fear(struct chunk *c, struct monster *mon)
 		 * First half of calculation is inversely proportional to distance
 		 * Second half is inversely proportional to grid's distance from player
 		 */
-		score = 5000 / (dis + 3) - 500 / (c->squares[y][x].cost + 1);
+		score = 5000 / (dis + 3) - 500 / (sq_cost(c, y, x) + 1);
 
 		/* No negative scores */
 		if (score < 0) score = 0;
@@ -380,7 +411,7 @@ static bool get_moves_fear(struct chunk *c, struct monster *mon)
 		if (score < best_score) continue;
 
 		/* Save the score and time */
-		best_when = c->squares[y][x].when;
+		best_when = sq_when(c, y, x);
 		best_score = score;
 
 		/* Save the location */
@@ -579,10 +610,10 @@ static bool find_safety(struct chunk *c, struct monster *mon)
 			if (!square_ispassable(cave, y, x)) continue;
 
 			/* Ignore grids very far from the player */
-			if (c->squares[y][x].when < c->squares[py][px].when) continue;
+			if (sq_when(c, y, x) < sq_when(c, py, px)) continue;
 
 			/* Ignore too-distant grids */
-			if (c->squares[y][x].cost > c->squares[fy][fx].cost + 2 * d)
+			if (sq_cost(c, y, x) > sq_cost(c, fy, fx) + 2 * d)
 				continue;
 
 			/* Check for absence of shot (more or less) */
@@ -832,16 +863,21 @@ static bool get_moves(struct chunk *c, struct monster *mon, int *dir)
 
 	/* Apply fear */
 	if (!done && (mon->min_range == flee_range)) {
-		/* Try to find safe place */
-		if (!find_safety(c, mon)) {
-			/* Just leg it away from the player */
-			y = (-y);
-			x = (-x);
-		} else {
+		int ny, nx;
+
+		/* Head down the flee field, which all monsters share */
+		if (cave_flow_downhill(c, FLOW_FLEE, mon->fy, mon->fx, &ny, &nx)) {
+			y = ny - mon->fy;
+			x = nx - mon->fx;
+		} else if (find_safety(c, mon)) {
 			/* Set a course for the safe place */
 			get_moves_fear(c, mon);
 			y = mon->ty - mon->fy;
 			x = mon->tx - mon->fx;
+		} else {
+			/* Just leg it away */
+			y = (-y);
+			x = (-x);
 		}
 
 		done = TRUE;
@@ -891,9 +927,9 @@ static bool monster_can_flow(struct chunk *c, struct monster *mon)
 	assert(c);
 
 	/* Check the flow (normal aaf is about 20) */
-	if ((c->squares[fy][fx].when == c->squares[player->py][player->px].when) &&
-	    (c->squares[fy][fx].cost < z_info->max_flow_depth) &&
-	    (c->squares[fy][fx].cost < mon->race->aaf))
+	if ((sq_when(c, fy, fx) == sq_when(c, player->py, player->px)) &&
+	    (sq_cost(c, fy, fx) < z_info->max_flow_depth) &&
+	    (sq_cost(c, fy, fx) < mon->race->aaf))
 		return TRUE;
 	return FALSE;
 }
@@ -1041,13 +1077,19 @@ static bool process_monster_multiply(struct chunk *c, struct monster *mon)
 
 	monster_lore *lore = get_lore(mon->race);
 
+	/* Other monsters only count if the player could learn they don't breed */
+	if (!rf_has(mon->race->flags, RF_MULTIPLY) &&
+		(!mflag_has(mon->mflag, MFLAG_VISIBLE) ||
+		 rf_has(lore->flags, RF_MULTIPLY)))
+		return FALSE;
+
 	/* Too many breeders on the level already */
 	if (num_repro >= z_info->repro_monster_max) return FALSE;
 
 	/* Count the adjacent monsters */
 	for (y = oy - 1; y <= mon->fy + 1; y++)
 		for (x = ox - 1; x <= mon->fx + 1; x++)
-			if (c->squares[y][x].mon > 0) k++;
+			if (sq_mon(c, y, x) > 0) k++;
 
 	/* Multiply slower in crowded areas */
 	if ((k < 4) && (k == 0 || one_in_(k * z_info->repro_monster_rate))) {
@@ -1104,6 +1146,58 @@ static bool process_monster_should_stagger(struct monster *mon)
 }
 
 
+/**
+ * The name of the monster taking its turn, for messages.  Most turns print
+ * nothing, so the name is only worked out when a message first asks for it,
+ * by monster_turn_name().
+ */
+struct monster_turn_name {
+	const struct monster *mon;
+	bool done;
+	char buf[80];
+};
+
+/**
+ * Names already worked out, by race and by how the monster is described.
+ * With MDESC_CAPITAL | MDESC_IND_HID the name depends on nothing else.
+ */
+#define MON_NAME_CACHE_SIZE 64
+static struct {
+	int key;
+	char name[80];
+} mon_name_cache[MON_NAME_CACHE_SIZE];
+
+/**
+ * Get the name of the monster taking its turn, as it is now
+ */
+static const char *monster_turn_name(struct monster_turn_name *m_name)
+{
+	const struct monster *mon = m_name->mon;
+	int seen, onscreen, key, slot;
+
+	if (m_name->done)
+		return m_name->buf;
+
+	/* Everything monster_desc() looks at for this mode */
+	seen = mflag_has(mon->mflag, MFLAG_VISIBLE) ? 1 : 0;
+	onscreen = panel_contains(mon->fy, mon->fx) ? 1 : 0;
+	key = (mon->race->ridx << 2) | (seen << 1) | onscreen;
+
+	/* Key 0 is never used, as race 0 is never a monster */
+	slot = key % MON_NAME_CACHE_SIZE;
+	if (mon_name_cache[slot].key != key) {
+		monster_desc(mon_name_cache[slot].name,
+					 sizeof(mon_name_cache[slot].name), mon,
+					 MDESC_CAPITAL | MDESC_IND_HID);
+		mon_name_cache[slot].key = key;
+	}
+
+	my_strcpy(m_name->buf, mon_name_cache[slot].name, sizeof(m_name->buf));
+	m_name->done = TRUE;
+	return m_name->buf;
+}
+
+
 /**
  * Work out if a monster can move through the grid, if necessary bashing 
  * down doors in the way.
@@ -1111,7 +1205,7 @@ static bool process_monster_should_stagger(struct monster *mon)
  * Returns TRUE if the monster is able to move through the grid.
  */
 static bool process_monster_can_move(struct chunk *c, struct monster *mon,
-		const char *m_name, int nx, int ny, bool *did_something)
+		struct monster_turn_name *m_name, int nx, int ny, bool *did_something)
 {
 	monster_lore *lore = get_lore(mon->race);
 
@@ -1139,7 +1233,7 @@ static bool process_monster_can_move(struct chunk *c, struct monster *mon,
 	/* Monster destroys walls (and doors) */
 	else if (rf_has(mon->race->flags, RF_KILL_WALL)) {
 		/* Forget the wall */
-		sqinfo_off(c->squares[ny][nx].info, SQUARE_MARK);
+		sqinfo_off(sq_info(c, ny, nx), SQUARE_MARK);
 
 		/* Notice */
 		square_destroy_wall(c, ny, nx);
@@ -1177,15 +1271,17 @@ static bool process_monster_can_move(struct chunk *c, struct monster *mon,
 
 			if (randint0(mon->hp / 10) > k) {
 				if (may_bash)
-					msg("%s slams against the door.", m_name);
+					msg("%s slams against the door.",
+						monster_turn_name(m_name));
 				else
-					msg("%s fiddles with the lock.", m_name);
+					msg("%s fiddles with the lock.",
+						monster_turn_name(m_name));
 
 				/* Reduce the power of the door by one */
 				square_set_door_lock(c, ny, nx, k - 1);
 			}
 		} else {
-			bool mark = sqinfo_has(c->squares[ny][nx].info, SQUARE_MARK);
+			bool mark = sqinfo_has(sq_info(c, ny, nx), SQUARE_MARK);
 
 			/* Handle viewable doors */
 			if (square_isview(c, ny, nx))
@@ -1199,7 +1295,7 @@ static bool process_monster_can_move(struct chunk *c, struct monster *mon,
 				disturb(player, 0);
 
 				if (mark) {
-					sqinfo_on(c->squares[ny][nx].info, SQUARE_MARK);
+					sqinfo_on(sq_info(c, ny, nx), SQUARE_MARK);
 					square_light_spot(c, ny, nx);
 				}
 
@@ -1208,7 +1304,7 @@ static bool process_monster_can_move(struct chunk *c, struct monster *mon,
 			} else if (rf_has(mon->race->flags, RF_OPEN_DOOR)) {
 				square_open_door(c, ny, nx);
 				if (mark) {
-					sqinfo_on(c->squares[ny][nx].info, SQUARE_MARK);
+					sqinfo_on(sq_info(c, ny, nx), SQUARE_MARK);
 					square_light_spot(c, ny, nx);
 				}
 			}
@@ -1233,7 +1329,7 @@ static bool process_monster_glyph(struct chunk *c, struct monster *mon,
 			msg("The rune of protection is broken!");
 
 		/* Forget the rune */
-		sqinfo_off(c->squares[ny][nx].info, SQUARE_MARK);
+		sqinfo_off(sq_info(c, ny, nx), SQUARE_MARK);
 
 		/* Break the rune */
 		square_remove_ward(c, ny, nx);
@@ -1265,7 +1361,8 @@ static int compare_monsters(const struct monster *mon1,
 /**
  * Try to push past / kill another monster.  Returns TRUE on success.
  */
-static bool process_monster_try_push(struct chunk *c, struct monster *mon, const char *m_name, int nx, int ny)
+static bool process_monster_try_push(struct chunk *c, struct monster *mon,
+		struct monster_turn_name *m_name, int nx, int ny)
 {
 	monster_type *mon1 = square_monster(c, ny, nx);
 	monster_lore *lore = get_lore(mon->race);
@@ -1297,8 +1394,8 @@ static bool process_monster_try_push(struct chunk *c, struct monster *mon, const
 			/* Note if visible */
 			if (mflag_has(mon->mflag, MFLAG_VISIBLE) &&
 				mflag_has(mon->mflag, MFLAG_VIEW))
-				msg("%s %s %s.", m_name, kill_ok ? "tramples over" : "pushes past",
-					n_name);
+				msg("%s %s %s.", monster_turn_name(m_name),
+					kill_ok ? "tramples over" : "pushes past", n_name);
 
 			/* Monster ate another monster */
 			if (kill_ok)
@@ -1315,8 +1412,8 @@ static bool process_monster_try_push(struct chunk *c, struct monster *mon, const
 /**
  * Grab all objects from the grid.
  */
-void process_monster_grab_objects(struct chunk *c, struct monster *mon, 
-		const char *m_name, int nx, int ny)
+static void process_monster_grab_objects(struct chunk *c,
+		struct monster *mon, struct monster_turn_name *m_name, int nx, int ny)
 {
 	monster_lore *lore = get_lore(mon->race);
 	struct object *obj = square_object(c, ny, nx);
@@ -1365,14 +1462,15 @@ void process_monster_grab_objects(struct chunk *c, struct monster *mon,
 				mflag_has(mon->mflag, MFLAG_VISIBLE) &&
 				square_isview(c, ny, nx) && !ignore_item_ok(obj)) {
 				/* Dump a message */
-				msg("%s tries to pick up %s, but fails.", m_name, o_name);
+				msg("%s tries to pick up %s, but fails.",
+					monster_turn_name(m_name), o_name);
 			}
 
 		/* Pick up the item */
 		} else if (rf_has(mon->race->flags, RF_TAKE_ITEM)) {
 			/* Describe observable situations */
 			if (square_isview(c, ny, nx) && !ignore_item_ok(obj))
-				msg("%s picks up %s.", m_name, o_name);
+				msg("%s picks up %s.", monster_turn_name(m_name), o_name);
 
 			/* Carry the object */
 			square_excise_object(c, ny, nx, obj);
@@ -1382,7 +1480,8 @@ void process_monster_grab_objects(struct chunk *c, struct monster *mon,
 		} else {
 			/* Describe observable situations */
 			if (square_isview(c, ny, nx) && !ignore_item_ok(obj))
-				msgt(MSG_DESTROY, "%s crushes %s.", m_name, o_name);
+				msgt(MSG_DESTROY, "%s crushes %s.", monster_turn_name(m_name),
+					 o_name);
 
 			/* Delete the object */
 			square_excise_object(c, ny, nx, obj);
@@ -1425,10 +1524,11 @@ static void process_monster(struct chunk *c, struct monster *mon)
 	int i;
 	int dir = 0;
 	bool stagger = FALSE;
-	char m_name[80];
+	struct monster_turn_name m_name;
 
-	/* Get the monster name */
-	monster_desc(m_name, sizeof(m_name), mon, MDESC_CAPITAL | MDESC_IND_HID);
+	/* The monster name is only worked out if a message needs it */
+	m_name.mon = mon;
+	m_name.done = FALSE;
 
 	/* Try to multiply - this can use up a turn */
 	if (process_monster_multiply(c, mon))
@@ -1457,7 +1557,7 @@ static void process_monster(struct chunk *c, struct monster *mon)
 		int nx = ox + ddx[d];
 
 		/* Check if we can move */
-		if (!process_monster_can_move(c, mon, m_name, nx, ny, &did_something))
+		if (!process_monster_can_move(c, mon, &m_name, nx, ny, &did_something))
 			continue;
 
 		/* Try to break the glyph if there is one */
@@ -1493,7 +1593,7 @@ static void process_monster(struct chunk *c, struct monster *mon)
 
 		/* A monster is in the way, try to push past/kill */
 		if (square_monster(c, ny, nx)) {
-			did_something = process_monster_try_push(c, mon, m_name, nx, ny);
+			did_something = process_monster_try_push(c, mon, &m_name, nx, ny);
 		} else {
 			/* Otherwise we can just move */
 			monster_swap(oy, ox, ny, nx);
@@ -1501,7 +1601,7 @@ static void process_monster(struct chunk *c, struct monster *mon)
 		}
 
 		/* Scan all objects in the grid */
-		process_monster_grab_objects(c, mon, m_name, nx, ny);
+		process_monster_grab_objects(c, mon, &m_name, nx, ny);
 	}
 
 	if (did_something) {
@@ -1561,14 +1661,21 @@ static void regen_monster(monster_type *mon)
  * (backwards, so we can excise any "freshly dead" monsters), energizing each
  * monster, and allowing fully energized monsters to move, attack, pass, etc.
  *
+ * Passes with a minimum energy (before the player moves) only look at the
+ * few monsters the scheduler lists as having that much, in the same order.
+ * Passive monsters far from the player are parked until something wakes
+ * them, and cost nothing in the meantime (see cave_monster_park()).
+ *
  * This function and its children are responsible for a considerable fraction
  * of the processor time in normal situations, greater if the character is
  * resting.
  */
 void process_monsters(struct chunk *c, int minimum_energy)
 {
-	int i;
+	int i, n;
 	int mspeed;
+	int top = cave_monster_max(c) - 1;
+	s16b *ready = NULL;
 
 	/* Only process some things every so often */
 	bool regen = FALSE;
@@ -1577,27 +1684,39 @@ void process_monsters(struct chunk *c, int minimum_energy)
 	if (turn % 100 == 0)
 		regen = TRUE;
 
+	/* Find the monsters with enough energy, or take them all */
+	if (minimum_energy > 0) {
+		ready = c->mon_ready;
+		n = cave_monster_sched_ready(c, minimum_energy, ready);
+	} else {
+		n = top;
+	}
+
 	/* Process the monsters (backwards) */
-	for (i = cave_monster_max(c) - 1; i >= 1; i--)
+	for (i = 0; i < n; i++)
 	{
 		monster_type *mon;
+		int m_idx = ready ? ready[i] : top - i;
 
 		/* Handle "leaving" */
 		if (player->is_dead || player->upkeep->generate_level) break;
 
 		/* Get a 'live' monster */
-		mon = cave_monster(cave, i);
+		mon = cave_monster(c, m_idx);
 		if (!mon->race) continue;
 
+		/* Parked monsters make up their turns when woken */
+		if (c->dormant_slot[m_idx]) continue;
+
 		/* Ignore monsters that have already been handled */
-		if (mflag_has(mon->mflag, MFLAG_HANDLED))
+		if (c->mon_handled[m_idx] == c->sched_turn)
 			continue;
 
 		/* Not enough energy to move yet */
 		if (mon->energy < minimum_energy) continue;
 
 		/* Prevent reprocessing */
-		mflag_on(mon->mflag, MFLAG_HANDLED);
+		c->mon_handled[m_idx] = c->sched_turn;
 
 		/* Handle monster regeneration if requested */
 		if (regen)
@@ -1611,14 +1730,15 @@ void process_monsters(struct chunk *c, int minimum_energy)
 			mspeed -= 10;
 
 		/* Give this monster some energy */
-		mon->energy += turn_energy(mspeed);
+		cave_monster_set_energy(c, m_idx,
+								(byte)(mon->energy + turn_energy(mspeed)));
 
 		/* End the turn of monsters without enough energy to move */
 		if (mon->energy < z_info->move_energy)
 			continue;
 
 		/* Use up "some" energy */
-		mon->energy -= z_info->move_energy;
+		cave_monster_set_energy(c, m_idx, mon->energy - z_info->move_energy);
 
 		/* Mimics lie in wait */
 		if (is_mimicking(mon)) continue;
@@ -1630,13 +1750,16 @@ void process_monsters(struct chunk *c, int minimum_energy)
 				continue;
 
 			/* Set this monster to be the current actor */
-			c->mon_current = i;
+			c->mon_current = m_idx;
 
 			/* Process the monster */
 			process_monster(c, mon);
 
 			/* Monster is no longer current */
 			c->mon_current = -1;
+		} else {
+			/* Park it if it is well out of the player's way */
+			cave_monster_park(c, m_idx);
 		}
 	}
 
@@ -1646,21 +1769,12 @@ void process_monsters(struct chunk *c, int minimum_energy)
 }
 
 /**
- * Clear 'moved' status from all monsters.
+ * Mark all monsters as ready for the next game turn.
  *
- * Clear noise if appropriate.
+ * The scheduler remembers which game turn each monster was last handled
+ * in, so this just starts a new one.
  */
 void reset_monsters(void)
 {
-	int i;
-	monster_type *mon;
-
-	/* Process the monsters (backwards) */
-	for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
-		/* Access the monster */
-		mon = cave_monster(cave, i);
-
-		/* Monster is ready to go again */
-		mflag_off(mon->mflag, MFLAG_HANDLED);
-	}
+	cave->sched_turn++;
 }
@@ -187,7 +187,7 @@ int call_monster(int y, int x)
 	mon_clear_timed(m_ptr, MON_TMD_SLEEP, MON_TMD_FLG_NOMESSAGE, FALSE);
 
 	/* Set it's energy to 0 */
-	m_ptr->energy = 0;
+	cave_monster_set_energy(cave, m_ptr->midx, 0);
 
 	return (m_ptr->race->level);
 }
@@ -253,8 +253,10 @@ int summon_specific(int y1, int x1, int lev, int type, bool delay, bool call)
 		return (call_monster(y, x));
 	}
 
-	/* Prepare allocation table */
-	get_mon_num_prep(summon_specific_okay);
+	/* Prepare allocation table, which depends on the kin base for S_KIN */
+	get_mon_num_prep_cached(summon_specific_okay, type == S_KIN ?
+							(const void *) kin_base :
+							(const void *) &summon_info[type]);
 
 	/* Pick a monster, using the level calculation */
 	race = get_mon_num((player->depth + lev) / 2 + 5);
@@ -275,7 +277,7 @@ int summon_specific(int y1, int x1, int lev, int type, bool delay, bool call)
 	/* If delay, try to let the player act before the summoned monsters,
 	 * including slowing down faster monsters for one turn */
 	if (delay) {
-		m_ptr->energy = 0;
+		cave_monster_set_energy(cave, m_ptr->midx, 0);
 		if (m_ptr->race->speed > player->state.speed)
 			mon_inc_timed(m_ptr, MON_TMD_SLOW, 1,
 				MON_TMD_FLG_NOMESSAGE, FALSE);
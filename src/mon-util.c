@@ -33,8 +33,31 @@
 #include "player-calcs.h"
 #include "player-timed.h"
 #include "player-util.h"
+#include "z-names.h"
 
 
+/**
+ * Name indexes for lookup_monster() and lookup_monster_base(), built on
+ * first use for whichever tables are current
+ */
+static struct name_index *race_names;
+static const struct monster_race *race_names_table;
+static struct name_index *base_names;
+static const struct monster_base *base_names_table;
+
+/**
+ * Forget the monster name indexes, when the tables they index go
+ */
+void monster_names_cleanup(void)
+{
+	name_index_free(race_names);
+	race_names = NULL;
+	race_names_table = NULL;
+	name_index_free(base_names);
+	base_names = NULL;
+	base_names_table = NULL;
+}
+
 /**
  * Returns the monster with the given name. If no monster has the exact name
  * given, returns the first monster with the given name as a (case-insensitive)
@@ -42,26 +65,26 @@
  */
 struct monster_race *lookup_monster(const char *name)
 {
-	int i;
-	struct monster_race *closest = NULL;
-	
-	/* Look for it */
-	for (i = 0; i < z_info->r_max; i++) {
-		struct monster_race *race = &r_info[i];
-		if (!race->name)
-			continue;
-
-		/* Test for equality */
-		if (streq(name, race->name))
-			return race;
-
-		/* Test for close matches */
-		if (!closest && my_stristr(race->name, name))
-			closest = race;
-	} 
-
-	/* Return our best match */
-	return closest;
+	struct monster_race *race;
+
+	/* Index the races */
+	if (!race_names || race_names_table != r_info) {
+		int i;
+
+		name_index_free(race_names);
+		race_names = name_index_new();
+		race_names_table = r_info;
+		for (i = 0; i < z_info->r_max; i++)
+			if (r_info[i].name)
+				name_index_add(race_names, r_info[i].name, &r_info[i]);
+	}
+
+	/* Look for an exact match, then a close one */
+	race = name_index_find(race_names, name);
+	if (!race)
+		race = name_index_search(race_names, name);
+
+	return race;
 }
 
 /**
@@ -69,15 +92,18 @@ struct monster_race *lookup_monster(const char *name)
  */
 monster_base *lookup_monster_base(const char *name)
 {
-	monster_base *base;
-
-	/* Look for it */
-	for (base = rb_info; base; base = base->next) {
-		if (streq(name, base->name))
-			return base;
+	/* Index the bases */
+	if (!base_names || base_names_table != rb_info) {
+		monster_base *base;
+
+		name_index_free(base_names);
+		base_names = name_index_new();
+		base_names_table = rb_info;
+		for (base = rb_info; base; base = base->next)
+			name_index_add(base_names, base->name, base);
 	}
 
-	return NULL;
+	return name_index_find(base_names, name);
 }
 
 /**
@@ -410,10 +436,17 @@ void update_monsters(bool full)
 {
 	int i;
 
-	/* Update each (live) monster */
+	/* Parked monsters stay out of reach only near where they were parked */
+	if (full)
+		cave_monster_anchor(cave, player->py, player->px);
+
+	/* Update each (live, awake) monster */
 	for (i = 1; i < cave_monster_max(cave); i++) {
 		struct monster *mon = cave_monster(cave, i);
 
+		/* Parked monsters can't be seen and don't care where the player is */
+		if (cave->dormant_slot[i]) continue;
+
 		/* Update the monster if alive */
 		if (mon->race)
 			update_mon(mon, cave, full);
@@ -469,20 +502,23 @@ void monster_swap(int y1, int x1, int y2, int x2)
 	struct monster *mon;
 
 	/* Monsters */
-	m1 = cave->squares[y1][x1].mon;
-	m2 = cave->squares[y2][x2].mon;
+	m1 = sq_mon(cave, y1, x1);
+	m2 = sq_mon(cave, y2, x2);
 
 	/* Update grids */
-	cave->squares[y1][x1].mon = m2;
-	cave->squares[y2][x2].mon = m1;
+	sq_mon(cave, y1, x1) = m2;
+	sq_mon(cave, y2, x2) = m1;
 
 	/* Monster 1 */
 	if (m1 > 0) {
 		mon = cave_monster(cave, m1);
 
 		/* Move monster */
+		cave_monster_unpark(cave, m1);
+		cave_monster_index_remove(cave, m1);
 		mon->fy = y2;
 		mon->fx = x2;
+		cave_monster_index_add(cave, m1);
 
 		/* Update monster */
 		update_mon(mon, cave, TRUE);
@@ -522,8 +558,11 @@ void monster_swap(int y1, int x1, int y2, int x2)
 		mon = cave_monster(cave, m2);
 
 		/* Move monster */
+		cave_monster_unpark(cave, m2);
+		cave_monster_index_remove(cave, m2);
 		mon->fy = y1;
 		mon->fx = x1;
+		cave_monster_index_add(cave, m2);
 
 		/* Update monster */
 		update_mon(mon, cave, TRUE);
@@ -632,6 +671,7 @@ void update_smart_learn(struct monster *m, struct player *p, int flag,
 						int pflag, int element)
 {
 	bool element_ok = ((element >= 0) && (element < ELEM_MAX));
+	struct monster_known_pstate *known = cave_monster_known(cave, m->midx);
 
 	/* Sanity check */
 	if (!flag && !element_ok) return;
@@ -656,21 +696,21 @@ void update_smart_learn(struct monster *m, struct player *p, int flag,
 	/* Learn the flag */
 	if (flag) {
 		if (player_of_has(p, flag))
-			of_on(m->known_pstate.flags, flag);
+			of_on(known->flags, flag);
 		else
-			of_off(m->known_pstate.flags, flag);
+			of_off(known->flags, flag);
 	}
 
 	/* Learn the pflag */
 	if (pflag) {
 		if (pf_has(player->state.pflags, pflag))
-			of_on(m->known_pstate.pflags, pflag);
+			of_on(known->pflags, pflag);
 		else
-			of_off(m->known_pstate.pflags, pflag);
+			of_off(known->pflags, pflag);
 	}
 
 	/* Learn the element */
 	if (element_ok)
-		m->known_pstate.el_info[element].res_level
+		known->el_info[element].res_level
 			= player->state.el_info[element].res_level;
 }
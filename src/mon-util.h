@@ -22,6 +22,7 @@
 #include "monster.h"
 
 /** Functions **/
+void monster_names_cleanup(void);
 monster_race *lookup_monster(const char *name);
 monster_base *lookup_monster_base(const char *name);
 bool monster_is_nonliving(struct monster_race *race);
@@ -298,11 +298,25 @@ typedef struct monster_race
 } monster_race;
 
 
+/**
+ * What a monster has learnt about the player, for choosing its spells.
+ * This is only needed when the monster casts, so the chunk keeps it apart
+ * from the monsters themselves (see cave_monster_known()).
+ */
+struct monster_known_pstate {
+	bitflag flags[OF_SIZE];
+	bitflag pflags[PF_SIZE];
+	struct element_info el_info[ELEM_MAX];
+};
+
 /**
  * Monster information, for a specific monster.
  *
  * Note: fy, fx constrain dungeon size to 256x256
  *
+ * The fields every monster needs every game turn come first, to keep them
+ * together in as few cache lines as possible.
+ *
  * The "held_obj" field points to the first object of a stack
  * of objects (if any) being carried by the monster (see above).
  */
@@ -317,9 +331,6 @@ typedef struct monster
 	s16b hp;			/* Current Hit points */
 	s16b maxhp;			/* Max Hit points */
 
-	s16b m_timed[MON_TMD_MAX]; /* Timed monster status effects */
-	s16b m_timed_val[MON_TMD_MAX]; /* Timed monster status effect power values */
-
 	byte mspeed;		/* Monster "speed" */
 	byte energy;		/* Monster "energy" */
 
@@ -327,18 +338,19 @@ typedef struct monster
 
 	bitflag mflag[MFLAG_SIZE];	/* Temporary monster flags */
 
-	struct object *mimicked_obj; /* Object this monster is mimicking */
-	struct object *held_obj;	/* Object being held (if any) */
-
-	byte attr;  		/* attr last used for drawing monster */
-
-	player_state known_pstate; /* Known player state */
+	s16b m_timed[MON_TMD_MAX]; /* Timed monster status effects */
+	s16b m_timed_val[MON_TMD_MAX]; /* Timed monster status effect power values */
 
     byte ty;		/**< Monster target */
     byte tx;
 
     byte min_range;	/**< What is the closest we want to be?  Not saved */
     byte best_range;	/**< How close do we want to be? Not saved */
+
+	struct object *mimicked_obj; /* Object this monster is mimicking */
+	struct object *held_obj;	/* Object being held (if any) */
+
+	byte attr;  		/* attr last used for drawing monster */
 } monster_type;
 
 /** Variables **/
@@ -29,16 +29,42 @@
 #include "obj-tval.h"
 #include "obj-util.h"
 
-/** Arrays holding an index of objects to generate for a given level */
+/**
+ * Arrays holding an index of objects to generate for a given level, as
+ * running totals of the allocation probabilities of the kinds in kidx order
+ */
 static u32b *obj_total;
-static byte *obj_alloc;
+static u32b *obj_alloc;
 
 static u32b *obj_total_great;
-static byte *obj_alloc_great;
+static u32b *obj_alloc_great;
+
+/**
+ * The same for each tval on its own: obj_tval_kinds lists the kinds in tval
+ * order, those of tval t starting at obj_tval_start[t], and the running
+ * totals start again from zero for each tval
+ */
+static int *obj_tval_kinds;
+static int *obj_tval_start;
+static u32b *obj_tval_alloc;
+static u32b *obj_tval_alloc_great;
 
 static s16b alloc_ego_size = 0;
 static alloc_entry *alloc_ego_table;
 
+/**
+ * The ego item table entries which can apply to each object kind, those for
+ * kidx k running from ego_kind_start[k] to ego_kind_start[k + 1] - 1
+ */
+static s16b *ego_kind_entries;
+static int *ego_kind_start;
+
+/**
+ * Room for the ego items ego_find_random() can pick from; no kind has more
+ * entries than there are in the ego allocation table
+ */
+static s16b *ego_picks;
+
 struct money {
 	char *name;
 	int type;
@@ -59,8 +85,8 @@ static void init_obj_make(void) {
 	/*** Initialize object allocation info ***/
 
 	/* Allocate and wipe */
-	obj_alloc = mem_zalloc((z_info->max_obj_depth + 1) * k_max * sizeof(byte));
-	obj_alloc_great = mem_zalloc((z_info->max_obj_depth + 1) * k_max * sizeof(byte));
+	obj_alloc = mem_zalloc((z_info->max_obj_depth + 1) * k_max * sizeof(u32b));
+	obj_alloc_great = mem_zalloc((z_info->max_obj_depth + 1) * k_max * sizeof(u32b));
 	obj_total = mem_zalloc((z_info->max_obj_depth + 1) * sizeof(u32b));
 	obj_total_great = mem_zalloc((z_info->max_obj_depth + 1) * sizeof(u32b));
 
@@ -71,9 +97,6 @@ static void init_obj_make(void) {
 		int min = kind->alloc_min;
 		int max = kind->alloc_max;
 
-		/* If an item doesn't have a rarity, move on */
-		if (!kind->alloc_prob) continue;
-
 		/* Go through all the dungeon levels */
 		for (lev = 0; lev <= z_info->max_obj_depth; lev++) {
 			int rarity = kind->alloc_prob;
@@ -81,12 +104,53 @@ static void init_obj_make(void) {
 			/* Save the probability in the standard table */
 			if ((lev < min) || (lev > max)) rarity = 0;
 			obj_total[lev] += rarity;
-			obj_alloc[(lev * k_max) + item] = rarity;
+			obj_alloc[(lev * k_max) + item] = obj_total[lev];
 
 			/* Save the probability in the "great" table if relevant */
 			if (!kind_is_good(kind)) rarity = 0;
 			obj_total_great[lev] += rarity;
-			obj_alloc_great[(lev * k_max) + item] = rarity;
+			obj_alloc_great[(lev * k_max) + item] = obj_total_great[lev];
+		}
+	}
+
+	/*** Initialize allocation info by tval ***/
+
+	obj_tval_kinds = mem_zalloc(k_max * sizeof(int));
+	obj_tval_start = mem_zalloc((TV_MAX + 1) * sizeof(int));
+	obj_tval_alloc = mem_zalloc((z_info->max_obj_depth + 1) * k_max * sizeof(u32b));
+	obj_tval_alloc_great = mem_zalloc((z_info->max_obj_depth + 1) * k_max * sizeof(u32b));
+
+	/* Count the kinds of each tval, then turn the counts into starts */
+	for (item = 1; item < k_max; item++)
+		obj_tval_start[k_info[item].tval + 1]++;
+	for (i = 1; i <= TV_MAX; i++)
+		obj_tval_start[i] += obj_tval_start[i - 1];
+
+	/* List the kinds by tval, keeping kidx order within each tval */
+	num = mem_zalloc(TV_MAX * sizeof(s16b));
+	for (item = 1; item < k_max; item++) {
+		int tval = k_info[item].tval;
+		obj_tval_kinds[obj_tval_start[tval] + num[tval]++] = item;
+	}
+	mem_free(num);
+
+	for (lev = 0; lev <= z_info->max_obj_depth; lev++) {
+		u32b *total = &obj_tval_alloc[lev * k_max];
+		u32b *total_great = &obj_tval_alloc_great[lev * k_max];
+		int tval;
+
+		for (tval = 0; tval < TV_MAX; tval++) {
+			u32b sum = 0, sum_great = 0;
+
+			for (i = obj_tval_start[tval]; i < obj_tval_start[tval + 1]; i++) {
+				int kidx = obj_tval_kinds[i];
+				int ind = lev * k_max + kidx;
+
+				sum += obj_alloc[ind] - obj_alloc[ind - 1];
+				sum_great += obj_alloc_great[ind] - obj_alloc_great[ind - 1];
+				total[i] = sum;
+				total_great[i] = sum_great;
+			}
 		}
 	}
 
@@ -155,6 +219,57 @@ static void init_obj_make(void) {
 	mem_free(aux);
 	mem_free(num);
 
+	/*** List the ego items which can apply to each kind ***/
+
+	ego_kind_start = mem_zalloc((k_max + 1) * sizeof(int));
+
+	/* Count, then turn the counts into starts, then fill in */
+	for (i = 0; i < alloc_ego_size; i++) {
+		struct ego_poss_item *poss;
+
+		ego = &e_info[alloc_ego_table[i].index];
+
+		/* XXX Ignore cursed items for now */
+		if (cursed_p(ego->flags)) continue;
+
+		for (poss = ego->poss_items; poss; poss = poss->next)
+			ego_kind_start[poss->kidx + 1]++;
+	}
+	for (item = 1; item <= k_max; item++)
+		ego_kind_start[item] += ego_kind_start[item - 1];
+
+	ego_kind_entries = mem_zalloc((ego_kind_start[k_max] + 1) * sizeof(s16b));
+	ego_picks = mem_zalloc((alloc_ego_size + 1) * sizeof(s16b));
+	aux = mem_zalloc(k_max * sizeof(s16b));
+	for (i = 0; i < alloc_ego_size; i++) {
+		struct ego_poss_item *poss;
+
+		ego = &e_info[alloc_ego_table[i].index];
+		if (cursed_p(ego->flags)) continue;
+
+		for (poss = ego->poss_items; poss; poss = poss->next) {
+			int kidx = poss->kidx;
+
+			/* Don't list an ego item twice for a kind */
+			if (aux[kidx] && ego_kind_entries[ego_kind_start[kidx] +
+											  aux[kidx] - 1] == i)
+				continue;
+
+			ego_kind_entries[ego_kind_start[kidx] + aux[kidx]++] = i;
+		}
+	}
+
+	/* Close up any gaps left by duplicates */
+	for (lev = 0, item = 0; item < k_max; item++) {
+		int start = ego_kind_start[item];
+
+		ego_kind_start[item] = lev;
+		for (i = 0; i < aux[item]; i++)
+			ego_kind_entries[lev++] = ego_kind_entries[start + i];
+	}
+	ego_kind_start[k_max] = lev;
+	mem_free(aux);
+
 	/*** Initialize money info ***/
 
 	/* Count the money types and make a list */
@@ -178,7 +293,14 @@ static void cleanup_obj_make(void) {
 		string_free(money_type[i].name);
 	}
 	mem_free(money_type);
+	mem_free(ego_kind_entries);
+	mem_free(ego_kind_start);
+	mem_free(ego_picks);
 	mem_free(alloc_ego_table);
+	mem_free(obj_tval_alloc_great);
+	mem_free(obj_tval_alloc);
+	mem_free(obj_tval_start);
+	mem_free(obj_tval_kinds);
 	mem_free(obj_total_great);
 	mem_free(obj_total);
 	mem_free(obj_alloc_great);
@@ -246,23 +368,25 @@ static int random_high_resist(struct object *obj, int *resist)
  */
 static struct ego_item *ego_find_random(struct object *obj, int level)
 {
-	int i, ood_chance;
+	int i, n = 0, ood_chance;
+	int kidx = obj->kind->kidx;
 	long total = 0L;
 
 	alloc_entry *table = alloc_ego_table;
 	struct ego_item *ego;
-	struct ego_poss_item *poss;
+	s16b *entries = &ego_kind_entries[ego_kind_start[kidx]];
+	int num = ego_kind_start[kidx + 1] - ego_kind_start[kidx];
+	s16b *picks = ego_picks;
 
-	/* Go through all possible ego items and find ones which fit this item */
-	for (i = 0; i < alloc_ego_size; i++) {
-		/* Reset any previous probability of this type being picked */
-		table[i].prob3 = 0;
+	/* Go through the ego items which fit this item */
+	for (i = 0; i < num; i++) {
+		int e = entries[i];
 
-		if (level < table[i].level)
+		if (level < table[e].level)
 			continue;
 
 		/* Access the ego item */
-		ego = &e_info[table[i].index];
+		ego = &e_info[table[e].index];
         
         /* enforce maximum */
         if (level > ego->alloc_max) continue;
@@ -273,30 +397,23 @@ static struct ego_item *ego_find_random(struct object *obj, int level)
             if (!one_in_(ood_chance)) continue;
         }
 
-		/* XXX Ignore cursed items for now */
-		if (cursed_p(ego->flags)) continue;
-
-		for (poss = ego->poss_items; poss; poss = poss->next)
-			if (poss->kidx == obj->kind->kidx) {
-				table[i].prob3 = table[i].prob2;
-				break;
-			}
-
 		/* Total */
-		total += table[i].prob3;
+		picks[n++] = e;
+		total += table[e].prob2;
 	}
 
 	if (total) {
 		long value = randint0(total);
-		for (i = 0; i < alloc_ego_size; i++) {
+		for (i = 0; i < n; i++) {
 			/* Found the entry */
-			if (value < table[i].prob3) break;
+			if (value < table[picks[i]].prob2) break;
 
 			/* Decrement */
-			value = value - table[i].prob3;
+			value = value - table[picks[i]].prob2;
 		}
 
-		return &e_info[table[i].index];
+		ego = &e_info[table[picks[i]].index];
+		return ego;
 	}
 
 	return NULL;
@@ -964,39 +1081,48 @@ bool kind_is_good(const object_kind *kind)
 }
 
 
+/**
+ * Find the first entry from `first` to `last` of a table of running totals
+ * whose total is past `value`
+ */
+static int obj_alloc_search(const u32b *sums, int first, int last, u32b value)
+{
+	while (first < last) {
+		int mid = (first + last) / 2;
+		if (sums[mid] > value)
+			last = mid;
+		else
+			first = mid + 1;
+	}
+
+	return first;
+}
+
 /**
  * Choose an object kind of a given tval given a dungeon level.
  */
 static struct object_kind *get_obj_num_by_kind(int level, bool good, int tval)
 {
-	/* This is the base index into obj_alloc for this dlev */
-	size_t ind, item;
+	/* This is the base index into obj_tval_alloc for this dlev */
+	size_t ind;
+	int first = obj_tval_start[tval], last = obj_tval_start[tval + 1] - 1;
 	u32b value;
-	int total = 0;
-	byte *objects = good ? obj_alloc_great : obj_alloc;
+	u32b *objects = good ? obj_tval_alloc_great : obj_tval_alloc;
+
+	/* No items of that tval at all */
+	if (last < first) return NULL;
 
 	/* Pick an object */
 	ind = level * z_info->k_max;
 
-	/* Get new total */
-	for (item = 1; item < z_info->k_max; item++)
-		if (objkind_byid(item)->tval == tval)
-			total += objects[ind + item];
-
 	/* No appropriate items of that tval */
-	if (!total) return NULL;
-	
-	value = randint0(total);
+	if (!objects[ind + last]) return NULL;
 	
-	for (item = 1; item < z_info->k_max; item++)
-		if (objkind_byid(item)->tval == tval) {
-			if (value < objects[ind + item]) break;
-
-			value -= objects[ind + item];
-		}
+	value = randint0(objects[ind + last]);
 
 	/* Return the item index */
-	return objkind_byid(item);
+	return objkind_byid(obj_tval_kinds[obj_alloc_search(objects + ind, first,
+														last, value)]);
 }
 
 /**
@@ -1027,22 +1153,11 @@ struct object_kind *get_obj_num(int level, bool good, int tval)
 	
 	if (!good) {
 		value = randint0(obj_total[level]);
-		for (item = 1; item < z_info->k_max; item++) {
-			/* Found it */
-			if (value < obj_alloc[ind + item]) break;
-
-			/* Decrement */
-			value -= obj_alloc[ind + item];
-		}
+		item = obj_alloc_search(obj_alloc + ind, 1, z_info->k_max - 1, value);
 	} else {
 		value = randint0(obj_total_great[level]);
-		for (item = 1; item < z_info->k_max; item++) {
-			/* Found it */
-			if (value < obj_alloc_great[ind + item]) break;
-
-			/* Decrement */
-			value -= obj_alloc_great[ind + item];
-		}
+		item = obj_alloc_search(obj_alloc_great + ind, 1, z_info->k_max - 1,
+								value);
 	}
 
 	/* Return the item index */
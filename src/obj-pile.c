@@ -681,9 +681,9 @@ bool floor_carry(struct chunk *c, int y, int x, struct object *drop, bool last)
 
 	/* Link to the first or last object in the pile */
 	if (last)
-		pile_insert_end(&c->squares[y][x].obj, drop);
+		pile_insert_end(&sq_obj(c, y, x), drop);
 	else
-		pile_insert(&c->squares[y][x].obj, drop);
+		pile_insert(&sq_obj(c, y, x), drop);
 
 	/* Redraw */
 	square_note_spot(c, y, x);
@@ -887,7 +887,7 @@ void drop_near(struct chunk *c, struct object *dropped, int chance, int y,
 	sound(MSG_DROP);
 
 	/* Message when an object falls under the player */
-	if (verbose && (cave->squares[by][bx].mon < 0) && !ignorable)
+	if (verbose && (sq_mon(cave, by, bx) < 0) && !ignorable)
 		msg("You feel something roll beneath your feet.");
 }
 
@@ -923,7 +923,7 @@ void push_object(int y, int x)
 	}
 
 	/* Disassociate the objects from the square */
-	cave->squares[y][x].obj = NULL;
+	sq_obj(cave, y, x) = NULL;
 
 	/* Set feature to an open door */
 	square_force_floor(cave, y, x);
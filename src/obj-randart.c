@@ -2854,6 +2854,9 @@ static errr init_names(void)
 		a->name = artifact_gen_name(a, name_sections);
 	}
 
+	/* The artifacts are known by their new names */
+	object_names_cleanup();
+
 	return 0;
 }
 
@@ -40,6 +40,7 @@
 #include "player-spell.h"
 #include "player-util.h"
 #include "randname.h"
+#include "z-names.h"
 #include "z-queue.h"
 
 struct object_base *kb_info;
@@ -338,30 +339,56 @@ struct object_kind *objkind_byid(int kidx) {
 
 /*** Textual<->numeric conversion ***/
 
+/**
+ * Name indexes for lookup_artifact_name() and lookup_sval(), built on first
+ * use for whichever tables are current
+ */
+static struct name_index *artifact_names;
+static const struct artifact *artifact_names_table;
+static struct name_index *sval_names;
+static const struct object_kind *sval_names_table;
+static int sval_names_count;
+
+/**
+ * Forget the object name indexes, when the tables they index go
+ */
+void object_names_cleanup(void)
+{
+	name_index_free(artifact_names);
+	artifact_names = NULL;
+	artifact_names_table = NULL;
+	name_index_free(sval_names);
+	sval_names = NULL;
+	sval_names_table = NULL;
+	sval_names_count = 0;
+}
+
 /**
  * Return the a_idx of the artifact with the given name
  */
 int lookup_artifact_name(const char *name)
 {
-	int i;
-	int a_idx = -1;
+	struct artifact *art;
 
-	/* Look for it */
-	for (i = 1; i < z_info->a_max; i++) {
-		struct artifact *art = &a_info[i];
-
-		/* Test for equality */
-		if (art->name && streq(name, art->name))
-			return i;
-		
-		/* Test for close matches */
-		if (strlen(name) >= 3 && art->name && my_stristr(art->name, name)
-			&& a_idx == -1)
-			a_idx = i;
+	/* Index the artifacts */
+	if (!artifact_names || artifact_names_table != a_info) {
+		int i;
+
+		name_index_free(artifact_names);
+		artifact_names = name_index_new();
+		artifact_names_table = a_info;
+		for (i = 1; i < z_info->a_max; i++)
+			if (a_info[i].name)
+				name_index_add(artifact_names, a_info[i].name, &a_info[i]);
 	}
 
+	/* Look for an exact match, then a close one */
+	art = name_index_find(artifact_names, name);
+	if (!art && strlen(name) >= 3)
+		art = name_index_search(artifact_names, name);
+
 	/* Return our best match */
-	return a_idx;
+	return art ? art - a_info : -1;
 }
 
 
@@ -371,28 +398,40 @@ int lookup_artifact_name(const char *name)
  */
 int lookup_sval(int tval, const char *name)
 {
-	int k;
+	struct object_kind *kind;
 	unsigned int r;
+	char key[1024];
 
 	if (sscanf(name, "%u", &r) == 1)
 		return r;
 
-	/* Look for it */
-	for (k = 0; k < z_info->k_max; k++) {
-		struct object_kind *kind = &k_info[k];
-		char cmp_name[1024];
-
-		if (!kind || !kind->name) continue;
-
-		obj_desc_name_format(cmp_name, sizeof cmp_name, 0, kind->name, 0,
-							 FALSE);
-
-		/* Found a match */
-		if (kind->tval == tval && !my_stricmp(cmp_name, name))
-			return kind->sval;
+	/* Index the kinds by tval and plain name (artifact loading adds kinds) */
+	if (!sval_names || sval_names_table != k_info ||
+		sval_names_count != z_info->k_max) {
+		int k;
+
+		name_index_free(sval_names);
+		sval_names = name_index_new();
+		sval_names_table = k_info;
+		sval_names_count = z_info->k_max;
+		for (k = 0; k < z_info->k_max; k++) {
+			char cmp_name[1024];
+
+			kind = &k_info[k];
+			if (!kind->name) continue;
+
+			obj_desc_name_format(cmp_name, sizeof cmp_name, 0, kind->name,
+								 0, FALSE);
+			strnfmt(key, sizeof(key), "%d:%s", kind->tval, cmp_name);
+			name_index_add(sval_names, key, kind);
+		}
 	}
 
-	return -1;
+	/* Look for it */
+	strnfmt(key, sizeof(key), "%d:%s", tval, name);
+	kind = name_index_find_nocase(sval_names, key);
+
+	return kind ? kind->sval : -1;
 }
 
 void object_short_name(char *buf, size_t max, const char *name)
@@ -34,6 +34,7 @@ bool is_unknown(const struct object *obj);
 unsigned check_for_inscrip(const struct object *obj, const char *inscrip);
 struct object_kind *lookup_kind(int tval, int sval);
 struct object_kind *objkind_byid(int kidx);
+void object_names_cleanup(void);
 int lookup_artifact_name(const char *name);
 int lookup_sval(int tval, const char *name);
 void object_short_name(char *buf, size_t max, const char *name);
@@ -630,7 +630,7 @@ static void ranged_helper(struct object *obj, int dir, int range, int shots,
 		event_signal_missile(EVENT_MISSILE, obj, see, y, x);
 
 		/* Try the attack on the monster at (x, y) if any */
-		if (cave->squares[y][x].mon > 0) {
+		if (sq_mon(cave, y, x) > 0) {
 			monster_type *m_ptr = square_monster(cave, y, x);
 			int visible = mflag_has(m_ptr->mflag, MFLAG_VISIBLE);
 
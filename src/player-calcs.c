@@ -2593,9 +2593,12 @@ void redraw_stuff(struct player *p)
 	/* Then the ones that require parameters to be supplied. */
 	if (p->upkeep->redraw & PR_MAP) {
 		/* Mark the whole map to be redrawn */
-		event_signal_point(EVENT_MAP, -1, -1);
+		event_signal_region(EVENT_MAP, loc(-1, -1), loc(-1, -1), NULL, 0);
 	}
 
+	/* Send the grids which changed this turn */
+	cave_flush_redraw(cave);
+
 	p->upkeep->redraw = 0;
 
 	/* Hack - don't update while resting or running, makes it over quicker */
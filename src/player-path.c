@@ -45,6 +45,7 @@
 
 
 static int terrain[MAX_PF_RADIUS][MAX_PF_RADIUS];
+static struct loc pf_queue[MAX_PF_RADIUS * MAX_PF_RADIUS];
 static char pf_result[MAX_PF_LENGTH];
 static int pf_result_index;
 
@@ -82,14 +83,50 @@ static void fill_terrain_info(void)
 	terrain[player->py - oy][player->px - ox] = 1;
 }
 
-#define MARK_DISTANCE(c,d) if ((c <= MAX_PF_LENGTH) && (c > d)) \
-							{ c = d; try_again = (TRUE); }
+/**
+ * Breadth first search outwards from the player over the terrain window,
+ * stopping as soon as the target grid (y, x) has a distance.
+ *
+ * Every step costs the same, so the first distance given to a grid is its
+ * shortest; grids on the edge of the window are reached but not expanded.
+ */
+static void path_search(int y, int x)
+{
+	int head = 0, tail = 0;
+
+	pf_queue[tail++] = loc(player->px, player->py);
+
+	while ((head < tail) && (terrain[y - oy][x - ox] == MAX_PF_LENGTH)) {
+		struct loc grid = pf_queue[head++];
+		int next_distance = terrain[grid.y - oy][grid.x - ox] + 1;
+		int dir;
+
+		/* Only the interior of the window is expanded */
+		if ((grid.y <= oy) || (grid.y >= ey - 1) ||
+			(grid.x <= ox) || (grid.x >= ex - 1))
+			continue;
+
+		if (next_distance >= MAX_PF_LENGTH) continue;
+
+		for (dir = 1; dir < 10; dir++) {
+			int next_y = grid.y + ddy[dir];
+			int next_x = grid.x + ddx[dir];
+
+			if (dir == 5) continue;
+
+			/* Only unreached, valid grids */
+			if (terrain[next_y - oy][next_x - ox] != MAX_PF_LENGTH) continue;
+
+			terrain[next_y - oy][next_x - ox] = next_distance;
+			pf_queue[tail++] = loc(next_x, next_y);
+		}
+	}
+}
 
 bool findpath(int y, int x)
 {
 	int i, j, k;
 	int dir = 10;
-	bool try_again;
 	int cur_distance;
 
 	fill_terrain_info();
@@ -97,7 +134,7 @@ bool findpath(int y, int x)
 	terrain[player->py - oy][player->px - ox] = 1;
 
 	if ((x >= ox) && (x < ex) && (y >= oy) && (y < ey)) {
-		if ((cave->squares[y][x].mon > 0) &&
+		if ((sq_mon(cave, y, x) > 0) &&
 			mflag_has(square_monster(cave, y, x)->mflag, MFLAG_VISIBLE))
 			terrain[y - oy][x - ox] = MAX_PF_LENGTH;
 
@@ -107,36 +144,8 @@ bool findpath(int y, int x)
 		return (FALSE);
 	}
 
-	/* 
-	 * And now starts the very naive and very 
-	 * inefficient pathfinding algorithm
-	 */
-	do {
-		try_again = FALSE;
-
-		for (j = oy + 1; j < ey - 1; j++) {
-			for (i = ox + 1; i < ex - 1; i++) {
-				cur_distance = terrain[j - oy][i - ox] + 1;
-
-				if ((cur_distance > 0) && (cur_distance < MAX_PF_LENGTH)) {
-					for (dir = 1; dir < 10; dir++) {
-						int next_y, next_x;
-						if (dir == 5)
-							dir++;
-						next_y = j - oy + ddy[dir];
-						next_x = i - ox + ddx[dir];
-
-						MARK_DISTANCE(terrain[next_y][next_x], cur_distance);
-					}
-				}
-			}
-		}
-
-		if (terrain[y - oy][x - ox] < MAX_PF_LENGTH)
-			try_again = FALSE;
-
-	}
-	while (try_again) ;
+	/* Find the distances out to the target */
+	path_search(y, x);
 
 	/* Failure */
 	if (terrain[y - oy][x - ox] == MAX_PF_LENGTH) {
@@ -153,8 +162,16 @@ bool findpath(int y, int x)
 	while ((i != player->px) || (j != player->py)) {
 		cur_distance = terrain[j - oy][i - ox] - 1;
 		for (k = 0; k < 8; k++) {
+			int next_y = j - oy + ddy[dir_search[k]];
+			int next_x = i - ox + ddx[dir_search[k]];
+
+			/* Stay inside the terrain window */
+			if ((next_y < 0) || (next_y >= MAX_PF_RADIUS) ||
+				(next_x < 0) || (next_x >= MAX_PF_RADIUS))
+				continue;
+
 			dir = dir_search[k];
-			if (terrain[j - oy + ddy[dir]][i - ox + ddx[dir]] == cur_distance)
+			if (terrain[next_y][next_x] == cur_distance)
 				break;
 		}
 
@@ -548,7 +565,7 @@ static bool run_test(void)
 
 
 		/* Visible monsters abort running */
-		if (cave->squares[row][col].mon > 0) {
+		if (sq_mon(cave, row, col) > 0) {
 			monster_type *m_ptr = square_monster(cave, row, col);
 
 			/* Visible monster */
@@ -625,7 +642,7 @@ static bool run_test(void)
 		if (row < 0 || col < 0) continue;
 
 		/* Visible monsters abort running */
-		if (cave->squares[row][col].mon > 0) {
+		if (sq_mon(cave, row, col) > 0) {
 			monster_type *m_ptr = square_monster(cave, row, col);
 			
 			/* Visible monster */
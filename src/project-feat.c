@@ -50,7 +50,7 @@ static void project_feature_handler_LIGHT_WEAK(project_feature_handler_context_t
 	const int y = context->y;
 
 	/* Turn on the light */
-	sqinfo_on(cave->squares[y][x].info, SQUARE_GLOW);
+	sqinfo_on(sq_info(cave, y, x), SQUARE_GLOW);
 
 	/* Grid is in line of sight */
 	if (square_isview(cave, y, x)) {
@@ -72,11 +72,11 @@ static void project_feature_handler_DARK_WEAK(project_feature_handler_context_t
 
 	if (player->depth != 0 || !is_daytime()) {
 		/* Turn off the light */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_GLOW);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_GLOW);
 
 		/* Hack -- Forget "boring" grids */
 		if (square_isfloor(cave, y, x))
-			sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+			sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 	}
 
 	/* Grid is in line of sight */
@@ -104,13 +104,13 @@ static void project_feature_handler_KILL_WALL(project_feature_handler_context_t
 	/* Granite */
 	if (square_iswall(cave, y, x) && !square_hasgoldvein(cave, y, x)) {
 		/* Message */
-		if (sqinfo_has(cave->squares[y][x].info, SQUARE_MARK)) {
+		if (sqinfo_has(sq_info(cave, y, x), SQUARE_MARK)) {
 			msg("The wall turns into mud!");
 			context->obvious = TRUE;
 		}
 
 		/* Forget the wall */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 		/* Destroy the wall */
 		square_destroy_wall(cave, y, x);
@@ -120,7 +120,7 @@ static void project_feature_handler_KILL_WALL(project_feature_handler_context_t
 	else if (square_iswall(cave, y, x) && square_hasgoldvein(cave, y, x))
 	{
 		/* Message */
-		if (sqinfo_has(cave->squares[y][x].info, SQUARE_MARK))
+		if (sqinfo_has(sq_info(cave, y, x), SQUARE_MARK))
 		{
 			msg("The vein turns into mud!");
 			msg("You have found something!");
@@ -128,7 +128,7 @@ static void project_feature_handler_KILL_WALL(project_feature_handler_context_t
 		}
 
 		/* Forget the wall */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 		/* Destroy the wall */
 		square_destroy_wall(cave, y, x);
@@ -141,14 +141,14 @@ static void project_feature_handler_KILL_WALL(project_feature_handler_context_t
 	else if (square_ismagma(cave, y, x) || square_isquartz(cave, y, x))
 	{
 		/* Message */
-		if (sqinfo_has(cave->squares[y][x].info, SQUARE_MARK))
+		if (sqinfo_has(sq_info(cave, y, x), SQUARE_MARK))
 		{
 			msg("The vein turns into mud!");
 			context->obvious = TRUE;
 		}
 
 		/* Forget the wall */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 		/* Destroy the wall */
 		square_destroy_wall(cave, y, x);
@@ -158,14 +158,14 @@ static void project_feature_handler_KILL_WALL(project_feature_handler_context_t
 	else if (square_isrubble(cave, y, x))
 	{
 		/* Message */
-		if (sqinfo_has(cave->squares[y][x].info, SQUARE_MARK))
+		if (sqinfo_has(sq_info(cave, y, x), SQUARE_MARK))
 		{
 			msg("The rubble turns into mud!");
 			context->obvious = TRUE;
 		}
 
 		/* Forget the wall */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 		/* Destroy the rubble */
 		square_destroy_rubble(cave, y, x);
@@ -185,14 +185,14 @@ static void project_feature_handler_KILL_WALL(project_feature_handler_context_t
 	else if (square_isdoor(cave, y, x))
 	{
 		/* Hack -- special message */
-		if (sqinfo_has(cave->squares[y][x].info, SQUARE_MARK))
+		if (sqinfo_has(sq_info(cave, y, x), SQUARE_MARK))
 		{
 			msg("The door turns into mud!");
 			context->obvious = TRUE;
 		}
 
 		/* Forget the wall */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 		/* Destroy the feature */
 		square_destroy_door(cave, y, x);
@@ -230,7 +230,7 @@ static void project_feature_handler_KILL_DOOR(project_feature_handler_context_t
 		}
 
 		/* Forget the door */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 		/* Destroy the feature */
 		if (square_isdoor(cave, y, x))
@@ -269,7 +269,7 @@ static void project_feature_handler_KILL_TRAP(project_feature_handler_context_t
 		}
 
 		/* Forget the trap */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_MARK);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_MARK);
 
 		/* Destroy the trap */
 		square_destroy_trap(cave, y, x);
@@ -297,7 +297,7 @@ static void project_feature_handler_MAKE_DOOR(project_feature_handler_context_t
 	const int y = context->y;
 
 	/* Require a grid without monsters */
-	if (cave->squares[y][x].mon) return;
+	if (sq_mon(cave, y, x)) return;
 
 	/* Require a floor grid */
 	if (!square_isfloor(cave, y, x)) return;
@@ -310,7 +310,7 @@ static void project_feature_handler_MAKE_DOOR(project_feature_handler_context_t
 	square_add_door(cave, y, x, TRUE);
 
 	/* Observe */
-	if (sqinfo_has(cave->squares[y][x].info, SQUARE_MARK))
+	if (sqinfo_has(sq_info(cave, y, x), SQUARE_MARK))
 		context->obvious = TRUE;
 
 	/* Update the visuals */
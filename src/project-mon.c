@@ -848,6 +848,7 @@ static bool project_m_monster_attack(project_monster_handler_context_t *context,
 	mon_clear_timed(m_ptr, MON_TMD_SLEEP, MON_TMD_FLG_NOMESSAGE, FALSE);
 
 	/* Hurt the monster */
+	cave_monster_unpark(cave, m_ptr->midx);
 	m_ptr->hp -= dam;
 
 	/* Dead monster */
@@ -1109,7 +1110,7 @@ bool project_m(int who, int r, int y, int x, int dam, int typ, int flg)
 	char m_name[80];
 	char m_poss[80];
 
-	int m_idx = cave->squares[y][x].mon;
+	int m_idx = sq_mon(cave, y, x);
 
 	project_monster_handler_f monster_handler = monster_handlers[typ];
 	project_monster_handler_context_t context = {
@@ -156,7 +156,7 @@ int project_path(struct loc *gp, int range, int y1, int x1, int y2, int x2, int
 
 			/* Sometimes stop at non-initial monsters/players */
 			if (flg & (PROJECT_STOP))
-				if ((n > 0) && (cave->squares[y][x].mon != 0)) break;
+				if ((n > 0) && (sq_mon(cave, y, x) != 0)) break;
 
 			/* Slant */
 			if (m) {
@@ -210,7 +210,7 @@ int project_path(struct loc *gp, int range, int y1, int x1, int y2, int x2, int
 
 			/* Sometimes stop at non-initial monsters/players */
 			if (flg & (PROJECT_STOP))
-				if ((n > 0) && (cave->squares[y][x].mon != 0)) break;
+				if ((n > 0) && (sq_mon(cave, y, x) != 0)) break;
 
 			/* Slant */
 			if (m) {
@@ -258,7 +258,7 @@ int project_path(struct loc *gp, int range, int y1, int x1, int y2, int x2, int
 
 			/* Sometimes stop at non-initial monsters/players */
 			if (flg & (PROJECT_STOP))
-				if ((n > 0) && (cave->squares[y][x].mon != 0)) break;
+				if ((n > 0) && (sq_mon(cave, y, x) != 0)) break;
 
 			/* Advance */
 			y += sy;
@@ -667,7 +667,7 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 		blast_grid[num_grids].y = y;
 		blast_grid[num_grids].x = x;
 		distance_to_grid[num_grids] = 0;
-		sqinfo_on(cave->squares[y][x].info, SQUARE_PROJECT);
+		sqinfo_on(sq_info(cave, y, x), SQUARE_PROJECT);
 		num_grids++;
 	}
 
@@ -712,7 +712,7 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 					blast_grid[num_grids].y = y;
 					blast_grid[num_grids].x = x;
 					distance_to_grid[num_grids] = 0;
-					sqinfo_on(cave->squares[y][x].info, SQUARE_PROJECT);
+					sqinfo_on(sq_info(cave, y, x), SQUARE_PROJECT);
 					num_grids++;
 				}
 
@@ -721,7 +721,7 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 					blast_grid[num_grids].y = y;
 					blast_grid[num_grids].x = x;
 					distance_to_grid[num_grids] = 0;
-					sqinfo_on(cave->squares[y][x].info, SQUARE_PROJECT);
+					sqinfo_on(sq_info(cave, y, x), SQUARE_PROJECT);
 					num_grids++;
 				}
 
@@ -776,7 +776,7 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 			blast_grid[num_grids].y = centre.y;
 			blast_grid[num_grids].x = centre.x;
 			distance_to_grid[num_grids] = 0;
-			sqinfo_on(cave->squares[centre.y][centre.x].info, SQUARE_PROJECT);
+			sqinfo_on(sq_info(cave, centre.y, centre.x), SQUARE_PROJECT);
 			num_grids++;
 		}
 
@@ -837,7 +837,7 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 						blast_grid[num_grids].y = y;
 						blast_grid[num_grids].x = x;
 						distance_to_grid[num_grids] = dist_from_centre;
-						sqinfo_on(cave->squares[y][x].info, SQUARE_PROJECT);
+						sqinfo_on(sq_info(cave, y, x), SQUARE_PROJECT);
 						num_grids++;
 					}
 				}
@@ -868,7 +868,7 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 							blast_grid[num_grids].y = y;
 							blast_grid[num_grids].x = x;
 							distance_to_grid[num_grids] = dist_from_centre;
-							sqinfo_on(cave->squares[y][x].info, SQUARE_PROJECT);
+							sqinfo_on(sq_info(cave, y, x), SQUARE_PROJECT);
 							num_grids++;
 						}
 					}
@@ -985,7 +985,7 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 			y = project_m_y;
 
 			/* Track if possible */
-			if (cave->squares[y][x].mon > 0) {
+			if (sq_mon(cave, y, x) > 0) {
 				monster_type *m_ptr = square_monster(cave, y, x);
 
 				/* Recall and track */
@@ -1036,7 +1036,7 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 		x = blast_grid[i].x;
 
 		/* Clear the mark */
-		sqinfo_off(cave->squares[y][x].info, SQUARE_PROJECT);
+		sqinfo_off(sq_info(cave, y, x), SQUARE_PROJECT);
 	}
 
 	/* Update stuff if needed */
@@ -167,9 +167,11 @@ static void wr_item(const object_type *obj)
 
 
 /**
- * Write a monster record (including held or mimicked objects)
+ * Write a monster record (including held or mimicked objects, and what it
+ * knows of the player)
  */
-static void wr_monster(const monster_type *mon)
+static void wr_monster(const monster_type *mon,
+					   const struct monster_known_pstate *known)
 {
 	size_t j;
 	struct object *obj = mon->held_obj; 
@@ -193,10 +195,10 @@ static void wr_monster(const monster_type *mon)
 		wr_byte(mon->mflag[j]);
 
 	for (j = 0; j < OF_SIZE; j++)
-		wr_byte(mon->known_pstate.flags[j]);
+		wr_byte(known->flags[j]);
 
 	for (j = 0; j < ELEM_MAX; j++)
-		wr_s16b(mon->known_pstate.el_info[j].res_level);
+		wr_s16b(known->el_info[j].res_level);
 
 	/* Write mimicked object marker, if any */
 	if (mon->mimicked_obj) {
@@ -624,11 +626,11 @@ void wr_stores(void)
 /**
  * Write the current dungeon terrain features and info flags
  *
- * Note that the cost and when fields of c->squares[y][x] are not saved
+ * Note that the cost and when planes of the chunk are not saved
  */
 static void wr_dungeon_aux(struct chunk *c)
 {
-	int y, x;
+	int n, size = c->height * c->width;
 	size_t i;
 
 	byte tmp8u;
@@ -641,26 +643,24 @@ static void wr_dungeon_aux(struct chunk *c)
 	wr_u16b(c->height);
 	wr_u16b(c->width);
 
-	/* Run length encoding of c->squares[y][x].info */
+	/* Run length encoding of the info plane */
 	for (i = 0; i < SQUARE_SIZE; i++) {
 		count = 0;
 		prev_char = 0;
 
-		/* Dump for each grid */
-		for (y = 0; y < c->height; y++) {
-			for (x = 0; x < c->width; x++) {
-				/* Extract the important c->squares[y][x].info flags */
-				tmp8u = c->squares[y][x].info[i];
-
-				/* If the run is broken, or too full, flush it */
-				if ((tmp8u != prev_char) || (count == MAX_UCHAR)) {
-					wr_byte((byte)count);
-					wr_byte((byte)prev_char);
-					prev_char = tmp8u;
-					count = 1;
-				} else /* Continue the run */
-					count++;
-			}
+		/* Dump for each grid, in plane order */
+		for (n = 0; n < size; n++) {
+			/* Extract the important info flags */
+			tmp8u = c->info[n * SQUARE_SIZE + i];
+
+			/* If the run is broken, or too full, flush it */
+			if ((tmp8u != prev_char) || (count == MAX_UCHAR)) {
+				wr_byte((byte)count);
+				wr_byte((byte)prev_char);
+				prev_char = tmp8u;
+				count = 1;
+			} else /* Continue the run */
+				count++;
 		}
 
 		/* Flush the data (if any) */
@@ -674,21 +674,19 @@ static void wr_dungeon_aux(struct chunk *c)
 	count = 0;
 	prev_char = 0;
 
-	/* Dump for each grid */
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
-			/* Extract a byte */
-			tmp8u = c->squares[y][x].feat;
+	/* Dump for each grid, in plane order */
+	for (n = 0; n < size; n++) {
+		/* Extract a byte */
+		tmp8u = c->feat[n];
 
-			/* If the run is broken, or too full, flush it */
-			if ((tmp8u != prev_char) || (count == MAX_UCHAR)) {
-				wr_byte((byte)count);
-				wr_byte((byte)prev_char);
-				prev_char = tmp8u;
-				count = 1;
-			} else /* Continue the run */
-				count++;
-		}
+		/* If the run is broken, or too full, flush it */
+		if ((tmp8u != prev_char) || (count == MAX_UCHAR)) {
+			wr_byte((byte)count);
+			wr_byte((byte)prev_char);
+			prev_char = tmp8u;
+			count = 1;
+		} else /* Continue the run */
+			count++;
 	}
 
 	/* Flush the data (if any) */
@@ -717,7 +715,7 @@ static void wr_objects_aux(struct chunk *c)
 	/* Write the objects */
 	for (y = 0; y < c->height; y++) {
 		for (x = 0; x < c->width; x++) {
-			struct object *obj = c->squares[y][x].obj;
+			struct object *obj = sq_obj(c, y, x);
 			while (obj) {
 				wr_item(obj);
 				obj = obj->next;
@@ -748,7 +746,7 @@ static void wr_monsters_aux(struct chunk *c)
 	for (i = 1; i < cave_monster_max(c); i++) {
 		const monster_type *mon = cave_monster(c, i);
 
-		wr_monster(mon);
+		wr_monster(mon, cave_monster_known(c, i));
 	}
 }
 
@@ -764,7 +762,7 @@ static void wr_traps_aux(struct chunk *c)
 
 	for (y = 0; y < c->height; y++) {
 		for (x = 0; x < c->width; x++) {
-			struct trap *trap = c->squares[y][x].trap;
+			struct trap *trap = sq_trap(c, y, x);
 			while (trap) {
 				wr_trap(trap);
 				trap = trap->next;
@@ -322,13 +322,13 @@ bool target_accept(int y, int x)
 	object_type *obj;
 
 	/* Player grids are always interesting */
-	if (cave->squares[y][x].mon < 0) return (TRUE);
+	if (sq_mon(cave, y, x) < 0) return (TRUE);
 
 	/* Handle hallucination */
 	if (player->timed[TMD_IMAGE]) return (FALSE);
 
 	/* Visible monsters */
-	if (cave->squares[y][x].mon > 0) {
+	if (sq_mon(cave, y, x) > 0) {
 		monster_type *mon = square_monster(cave, y, x);
 
 		/* Visible monsters */
@@ -442,7 +442,7 @@ struct point_set *target_get_monsters(int mode)
 			/* Special mode */
 			if (mode & (TARGET_KILL)) {
 				/* Must contain a monster */
-				if (!(cave->squares[y][x].mon > 0)) continue;
+				if (!(sq_mon(cave, y, x) > 0)) continue;
 
 				/* Must be a targettable monster */
 			 	if (!target_able(square_monster(cave, y, x))) continue;
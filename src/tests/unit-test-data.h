@@ -978,9 +978,12 @@ static struct chunk TEST_DATA test_cave = {
 	.feat_count = NULL,
 
 	.feat = NULL,
-	.m_idx = NULL,
-
-	.squares = NULL,
+	.info = NULL,
+	.cost = NULL,
+	.when = NULL,
+	.mon = NULL,
+	.obj = NULL,
+	.trap = NULL,
 
 	.monsters = NULL,
 	.mon_max = 1,
@@ -0,0 +1,110 @@
+/* z-names/names.c */
+
+#include "unit-test.h"
+#include "z-names.h"
+#include "z-form.h"
+
+static int values[100];
+
+int setup_tests(void **state) {
+	struct name_index *ix = name_index_new();
+	name_index_add(ix, "Grip, Farmer Maggot's Dog", &values[0]);
+	name_index_add(ix, "Fang, Farmer Maggot's Dog", &values[1]);
+	name_index_add(ix, "Cave spider", &values[2]);
+	name_index_add(ix, "cave spider", &values[3]);
+	name_index_add(ix, "Cave spider", &values[4]);
+	*state = ix;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	name_index_free(state);
+	return 0;
+}
+
+int test_find(void *state) {
+	struct name_index *ix = state;
+
+	ptreq(name_index_find(ix, "Grip, Farmer Maggot's Dog"), &values[0]);
+	ptreq(name_index_find(ix, "Fang, Farmer Maggot's Dog"), &values[1]);
+	ptreq(name_index_find(ix, "cave spider"), &values[3]);
+	null(name_index_find(ix, "grip, farmer maggot's dog"));
+	null(name_index_find(ix, "Grip"));
+	ok;
+}
+
+int test_find_nocase(void *state) {
+	struct name_index *ix = state;
+
+	ptreq(name_index_find_nocase(ix, "GRIP, FARMER MAGGOT'S DOG"), &values[0]);
+	ptreq(name_index_find_nocase(ix, "fang, farmer maggot's dog"), &values[1]);
+	null(name_index_find_nocase(ix, "Fang"));
+	ok;
+}
+
+int test_first_wins(void *state) {
+	struct name_index *ix = state;
+
+	/* Of three equal names, the first added is found */
+	ptreq(name_index_find(ix, "Cave spider"), &values[2]);
+	ptreq(name_index_find_nocase(ix, "CAVE SPIDER"), &values[2]);
+	ptreq(name_index_search(ix, "spider"), &values[2]);
+	ptreq(name_index_search(ix, "Maggot"), &values[0]);
+	ok;
+}
+
+int test_search(void *state) {
+	struct name_index *ix = state;
+
+	ptreq(name_index_search(ix, "fang"), &values[1]);
+	ptreq(name_index_search(ix, "MAGGOT'S DOG"), &values[0]);
+	ptreq(name_index_search(ix, "ave spi"), &values[2]);
+	null(name_index_search(ix, "dragon"));
+	ok;
+}
+
+int test_search_short(void *state) {
+	struct name_index *ix = state;
+
+	/* Parts too short to have a trigram */
+	ptreq(name_index_search(ix, "Fa"), &values[0]);
+	ptreq(name_index_search(ix, "g,"), &values[1]);
+	ptreq(name_index_search(ix, "v"), &values[2]);
+	null(name_index_search(ix, "qz"));
+	ok;
+}
+
+int test_rehash(void *state) {
+	struct name_index *ix = name_index_new();
+	char buf[32];
+	int i;
+
+	/* Enough names to outgrow the first table */
+	for (i = 0; i < 100; i++) {
+		strnfmt(buf, sizeof(buf), "Name number %d", i);
+		name_index_add(ix, buf, &values[i]);
+	}
+
+	for (i = 0; i < 100; i++) {
+		strnfmt(buf, sizeof(buf), "Name number %d", i);
+		ptreq(name_index_find(ix, buf), &values[i]);
+		strnfmt(buf, sizeof(buf), "NAME NUMBER %d", i);
+		ptreq(name_index_find_nocase(ix, buf), &values[i]);
+	}
+	ptreq(name_index_search(ix, "number 99"), &values[99]);
+	ptreq(name_index_search(ix, "number 1"), &values[1]);
+
+	name_index_free(ix);
+	ok;
+}
+
+const char *suite_name = "z-names/names";
+struct test tests[] = {
+	{ "find", test_find },
+	{ "find_nocase", test_find_nocase },
+	{ "first_wins", test_first_wins },
+	{ "search", test_search },
+	{ "search_short", test_search_short },
+	{ "rehash", test_rehash },
+	{ NULL, NULL }
+};
@@ -1091,83 +1091,110 @@ static void update_statusline(game_event_type type, game_event_data *data, void
 static void trace_map_updates(game_event_type type, game_event_data *data,
 							  void *user)
 {
-	if (data->point.x == -1 && data->point.y == -1)
+	if (data->region.min.x == -1 && data->region.min.y == -1)
 		printf("Redraw whole map\n");
 	else
-		printf("Redraw (%i, %i)\n", data->point.x, data->point.y);
+		printf("Redraw (%i, %i) to (%i, %i)\n", data->region.min.x,
+			   data->region.min.y, data->region.max.x, data->region.max.y);
 }
 #endif
 
 /**
- * Update either a single map grid or a whole map
+ * Queue the redraw of a single map grid on a map term
  */
-static void update_maps(game_event_type type, game_event_data *data, void *user)
+static void update_map_grid(term *t, int y, int x)
 {
-	term *t = user;
-
-	/* This signals a whole-map redraw. */
-	if (data->point.x == -1 && data->point.y == -1)
-		prt_map();
-
-	/* Single point to be redrawn */
-	else {
-		grid_data g;
-		int a, ta;
-		wchar_t c, tc;
+	grid_data g;
+	int a, ta;
+	wchar_t c, tc;
 
-		int ky, kx;
-		int vy, vx;
+	int ky, kx;
+	int vy, vx;
 
-		/* Location relative to panel */
-		ky = data->point.y - t->offset_y;
-		kx = data->point.x - t->offset_x;
+	/* Location relative to panel */
+	ky = y - t->offset_y;
+	kx = x - t->offset_x;
 
-		if (t == angband_term[0]) {
-			/* Verify location */
-			if ((ky < 0) || (ky >= SCREEN_HGT)) return;
+	if (t == angband_term[0]) {
+		/* Verify location */
+		if ((ky < 0) || (ky >= SCREEN_HGT)) return;
 
-			/* Verify location */
-			if ((kx < 0) || (kx >= SCREEN_WID)) return;
+		/* Verify location */
+		if ((kx < 0) || (kx >= SCREEN_WID)) return;
 
-			/* Location in window */
-			vy = ky + ROW_MAP;
-			vx = kx + COL_MAP;
+		/* Location in window */
+		vy = ky + ROW_MAP;
+		vx = kx + COL_MAP;
 
-			if (tile_width > 1)
-				vx += (tile_width - 1) * kx;
+		if (tile_width > 1)
+			vx += (tile_width - 1) * kx;
 
-			if (tile_height > 1)
-				vy += (tile_height - 1) * ky;
+		if (tile_height > 1)
+			vy += (tile_height - 1) * ky;
 
-		} else {
-			if (tile_width > 1)
-			        kx += (tile_width - 1) * kx;
+	} else {
+		if (tile_width > 1)
+		        kx += (tile_width - 1) * kx;
 
-			if (tile_height > 1)
-			        ky += (tile_height - 1) * ky;
+		if (tile_height > 1)
+		        ky += (tile_height - 1) * ky;
 
-			
-			/* Verify location */
-			if ((ky < 0) || (ky >= t->hgt)) return;
-			if ((kx < 0) || (kx >= t->wid)) return;
+		
+		/* Verify location */
+		if ((ky < 0) || (ky >= t->hgt)) return;
+		if ((kx < 0) || (kx >= t->wid)) return;
 
-			/* Location in window */
-			vy = ky;
-			vx = kx;
-		}
+		/* Location in window */
+		vy = ky;
+		vx = kx;
+	}
 
 
-		/* Redraw the grid spot */
-		map_info(data->point.y, data->point.x, &g);
-		grid_data_as_text(&g, &a, &c, &ta, &tc);
-		Term_queue_char(t, vx, vy, a, c, ta, tc);
+	/* Redraw the grid spot */
+	map_info(y, x, &g);
+	grid_data_as_text(&g, &a, &c, &ta, &tc);
+	Term_queue_char(t, vx, vy, a, c, ta, tc);
 #ifdef MAP_DEBUG
-		/* Plot 'spot' updates in light green to make them visible */
-		Term_queue_char(t, vx, vy, COLOUR_L_GREEN, c, ta, tc);
+	/* Plot 'spot' updates in light green to make them visible */
+	Term_queue_char(t, vx, vy, COLOUR_L_GREEN, c, ta, tc);
 #endif
 
-		if ((tile_width > 1) || (tile_height > 1))
-			Term_big_queue_char(t, vx, vy, a, c, COLOUR_WHITE, ' ');
+	if ((tile_width > 1) || (tile_height > 1))
+		Term_big_queue_char(t, vx, vy, a, c, COLOUR_WHITE, ' ');
+}
+
+/**
+ * Update either a region of map grids or a whole map
+ */
+static void update_maps(game_event_type type, game_event_data *data, void *user)
+{
+	term *t = user;
+	struct loc min = data->region.min;
+	struct loc max = data->region.max;
+
+	/* This signals a whole-map redraw. */
+	if (min.x == -1 && min.y == -1)
+		prt_map();
+
+	/* Grids to be redrawn */
+	else {
+		int y, x;
+
+		for (y = min.y; y <= max.y; y++) {
+			const u32b *row = data->region.grids ?
+				data->region.grids + y * data->region.stride : NULL;
+
+			for (x = min.x; x <= max.x; x++) {
+				/* Skip whole empty words at once */
+				if (row && !row[x >> 5]) {
+					x |= 31;
+					continue;
+				}
+
+				if (!row || (row[x >> 5] & ((u32b) 1 << (x & 31))))
+					update_map_grid(t, y, x);
+			}
+		}
 	}
 
 	/* Refresh the main screen */
@@ -1388,7 +1415,7 @@ static void display_explosion(game_event_type type, game_event_data *data,
 
 			/* Erase visible, valid grids */
 			if (player_sees_grid[i])
-				event_signal_point(EVENT_MAP, x, y);
+				event_signal_region(EVENT_MAP, loc(x, y), loc(x, y), NULL, 0);
 		}
 
 		/* Center the cursor */
@@ -1434,7 +1461,7 @@ static void display_bolt(game_event_type type, game_event_data *data,
 		if (player->upkeep->redraw)
 			redraw_stuff(player);
 		Term_xtra(TERM_XTRA_DELAY, msec);
-		event_signal_point(EVENT_MAP, x, y);
+		event_signal_region(EVENT_MAP, loc(x, y), loc(x, y), NULL, 0);
 		Term_fresh();
 		if (player->upkeep->redraw)
 			redraw_stuff(player);
@@ -1481,7 +1508,7 @@ static void display_missile(game_event_type type, game_event_data *data,
 		if (player->upkeep->redraw) redraw_stuff(player);
 
 		Term_xtra(TERM_XTRA_DELAY, msec);
-		event_signal_point(EVENT_MAP, x, y);
+		event_signal_region(EVENT_MAP, loc(x, y), loc(x, y), NULL, 0);
 
 		Term_fresh();
 		if (player->upkeep->redraw) redraw_stuff(player);
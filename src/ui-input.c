@@ -17,6 +17,7 @@
  */
 
 #include "angband.h"
+#include "cave.h"
 #include "cmds.h"
 #include "game-event.h"
 #include "game-input.h"
@@ -351,6 +352,10 @@ static void msg_flush(int x)
 {
 	byte a = COLOUR_L_BLUE;
 
+	/* Show the map changes that go with the message */
+	if (character_generated && textui_map_is_visible())
+		cave_flush_redraw(cave);
+
 	/* Pause for response */
 	Term_putstr(x, 0, -1, a, "-more-");
 
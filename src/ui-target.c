@@ -246,8 +246,8 @@ static ui_event target_recall_loop_object(object_type *o_ptr, int y, int x,
 			if (player->wizard) {
 				strnfmt(out_val, TARGET_OUT_VAL_SIZE,
 						"%s%s%s%s, %s (%d:%d, cost=%d, when=%d).", s1, s2, s3,
-						o_name, coords, y, x, (int)cave->squares[y][x].cost,
-						(int)cave->squares[y][x].when);
+						o_name, coords, y, x, (int)sq_cost(cave, y, x),
+						(int)sq_when(cave, y, x));
 			} else {
 				strnfmt(out_val, TARGET_OUT_VAL_SIZE,
 						"%s%s%s%s, %s.", s1, s2, s3, o_name, coords);
@@ -331,7 +331,7 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 
 
 		/* The player */
-		if (cave->squares[y][x].mon < 0) {
+		if (sq_mon(cave, y, x) < 0) {
 			/* Description */
 			s1 = "You are ";
 
@@ -347,8 +347,8 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 			if (player->wizard)
 				strnfmt(out_val, sizeof(out_val),
 						"%s%s%s%s, %s (%d:%d, cost=%d, when=%d).", s1, s2, s3,
-						name, coords, y, x, (int)cave->squares[y][x].cost,
-						(int)cave->squares[y][x].when);
+						name, coords, y, x, (int)sq_cost(cave, y, x),
+						(int)sq_when(cave, y, x));
 			else
 				strnfmt(out_val, sizeof(out_val), "%s%s%s%s, %s.",
 						s1, s2, s3, name, coords);
@@ -367,7 +367,7 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 		}
 
 		/* Actual monsters */
-		if (cave->squares[y][x].mon > 0) {
+		if (sq_mon(cave, y, x) > 0) {
 			monster_type *m_ptr = square_monster(cave, y, x);
 			const monster_lore *l_ptr = get_lore(m_ptr->race);
 
@@ -404,15 +404,15 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 
 						/* Describe the monster */
 						look_mon_desc(buf, sizeof(buf),
-									  cave->squares[y][x].mon);
+									  sq_mon(cave, y, x));
 
 						/* Describe, and prompt for recall */
 						if (player->wizard) {
 							strnfmt(out_val, sizeof(out_val),
 									"%s%s%s%s (%s), %s (%d:%d, cost=%d, when=%d).",
 									s1, s2, s3, m_name, buf, coords, y, x,
-									(int)cave->squares[y][x].cost,
-									(int)cave->squares[y][x].when);
+									(int)sq_cost(cave, y, x),
+									(int)sq_when(cave, y, x));
 						} else {
 							strnfmt(out_val, sizeof(out_val),
 									"%s%s%s%s (%s), %s.",
@@ -477,8 +477,8 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 						strnfmt(out_val, sizeof(out_val),
 								"%s%s%s%s, %s (%d:%d, cost=%d, when=%d).",
 								s1, s2, s3, o_name, coords, y, x,
-								(int)cave->squares[y][x].cost,
-								(int)cave->squares[y][x].when);
+								(int)sq_cost(cave, y, x),
+								(int)sq_when(cave, y, x));
 					}
 
 					prt(out_val, 0, 0);
@@ -518,7 +518,7 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 
 		/* A trap */
 		if (square_isvisibletrap(cave, y, x)) {
-			struct trap *trap = cave->squares[y][x].trap;
+			struct trap *trap = sq_trap(cave, y, x);
 
 			/* Not boring */
 			boring = FALSE;
@@ -526,7 +526,7 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 			/* Interact */
 			while (1) {
 				/* Change the intro */
-				if (cave->squares[y][x].mon < 0) {
+				if (sq_mon(cave, y, x) < 0) {
 					s1 = "You are ";
 					s2 = "on ";
 				} else {
@@ -542,8 +542,8 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 					strnfmt(out_val, sizeof(out_val),
 							"%s%s%s%s, %s (%d:%d, cost=%d, when=%d).", s1, s2,
 							s3, trap->kind->name, coords, y, x,
-							(int)cave->squares[y][x].cost,
-							(int)cave->squares[y][x].when);
+							(int)sq_cost(cave, y, x),
+							(int)sq_when(cave, y, x));
 				} else {
 					strnfmt(out_val, sizeof(out_val), "%s%s%s%s, %s.", 
 							s1, s2, s3, trap->kind->name, coords);
@@ -592,8 +592,8 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 						strnfmt(out_val, sizeof(out_val),
 								"%s%s%sa pile of %d objects, %s (%d:%d, cost=%d, when=%d).",
 								s1, s2, s3, floor_num, coords, y, x,
-								(int)cave->squares[y][x].cost,
-								(int)cave->squares[y][x].when);
+								(int)sq_cost(cave, y, x),
+								(int)sq_when(cave, y, x));
 					} else {
 						strnfmt(out_val, sizeof(out_val),
 								"%s%s%sa pile of %d objects, %s.",
@@ -695,8 +695,8 @@ static ui_event target_set_interactive_aux(int y, int x, int mode)
 			if (player->wizard) {
 				strnfmt(out_val, sizeof(out_val),
 						"%s%s%s%s, %s (%d:%d, cost=%d, when=%d).", s1, s2, s3,
-						name, coords, y, x, (int)cave->squares[y][x].cost,
-						(int)cave->squares[y][x].when);
+						name, coords, y, x, (int)sq_cost(cave, y, x),
+						(int)sq_when(cave, y, x));
 			} else {
 				strnfmt(out_val, sizeof(out_val),
 						"%s%s%s%s, %s.", s1, s2, s3, name, coords);
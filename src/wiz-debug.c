@@ -149,10 +149,10 @@ static void do_cmd_wiz_hack_ben(void)
 				if (!square_in_bounds_fully(cave, y, x)) continue;
 
 				/* Display proper cost */
-				if (cave->squares[y][x].cost != i) continue;
+				if (sq_cost(cave, y, x) != i) continue;
 
 				/* Reliability in yellow */
-				if (cave->squares[y][x].when == cave->squares[py][px].when)
+				if (sq_when(cave, y, x) == sq_when(cave, py, px))
 					a = COLOUR_YELLOW;
 
 				/* Display player/floors/walls */
@@ -1418,6 +1418,7 @@ static void do_cmd_wiz_zap(int d)
 	int i;
 
 	/* Banish everyone nearby */
+	cave_monster_unpark_all(cave);
 	for (i = 1; i < cave_monster_max(cave); i++)
 	{
 		struct monster *mon = cave_monster(cave, i);
@@ -1485,7 +1486,7 @@ static void do_cmd_wiz_query(void)
 			if (!square_in_bounds_fully(cave, y, x)) continue;
 
 			/* Given flag, show only those grids */
-			if (!sqinfo_has(cave->squares[y][x].info, flag)) continue;
+			if (!sqinfo_has(sq_info(cave, y, x), flag)) continue;
 
 			/* Given no flag, show unknown grids */
 			if (!flag && (!square_ismark(cave, y, x))) continue;
@@ -1592,7 +1593,7 @@ static void do_cmd_wiz_features(void)
 
 			/* Given feature, show only those grids */
 			for (i = 0; i < length; i++)
-				if (cave->squares[y][x].feat == feat[i]) show = TRUE;
+				if (sq_feat(cave, y, x) == feat[i]) show = TRUE;
 
 			/* Color */
 			if (square_ispassable(cave, y, x)) a = COLOUR_YELLOW;
@@ -0,0 +1,233 @@
+/**
+ * \file z-names.c
+ * \brief Indexes of named things, for lookup by name
+ *
+ * An index maps names to values (usually pointers into the game's info
+ * arrays).  Exact lookups, with or without case, go through hash chains.
+ * Lookups by part of a name check only the names sharing the rarest
+ * three-letter run (trigram) of the part.
+ *
+ * Where several names match, the one added first wins, so lookups give the
+ * same answers as a scan of the names in the order they were added.
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "z-names.h"
+
+#include "z-util.h"
+#include "z-virt.h"
+
+#define NAME_TRIGRAMS	1024
+
+struct name_entry {
+	char *name;
+	void *value;
+	u32b hash;
+	u32b fold_hash;
+	int next;				/* Next entry in hash chain, plus one */
+	int fold_next;			/* Next entry in caseless hash chain, plus one */
+};
+
+struct name_posting {
+	int *ids;
+	size_t filled;
+	size_t allocated;
+};
+
+struct name_index {
+	struct name_entry *entries;
+	size_t filled;
+	size_t allocated;
+
+	int *chains;			/* First entry in each hash chain, plus one */
+	int *fold_chains;		/* First entry in each caseless chain, plus one */
+	size_t buckets;
+
+	struct name_posting trigrams[NAME_TRIGRAMS];
+};
+
+static u32b _name_hash(const char *s, bool fold) {
+	u32b h = 5381;
+	for (; *s; s++) {
+		int c = fold ? toupper((unsigned char)*s) : (unsigned char)*s;
+		h = h * 33 + c;
+	}
+	return h;
+}
+
+static size_t _name_trigram(const char *s) {
+	u32b t = toupper((unsigned char)s[0]);
+	t = t * 31 + toupper((unsigned char)s[1]);
+	t = t * 31 + toupper((unsigned char)s[2]);
+	return t % NAME_TRIGRAMS;
+}
+
+static void _name_link(struct name_index *ix, int id) {
+	struct name_entry *e = &ix->entries[id];
+	size_t b;
+
+	/* The first of several equal names is the one found */
+	if (!name_index_find(ix, e->name)) {
+		b = e->hash % ix->buckets;
+		e->next = ix->chains[b];
+		ix->chains[b] = id + 1;
+	}
+	if (!name_index_find_nocase(ix, e->name)) {
+		b = e->fold_hash % ix->buckets;
+		e->fold_next = ix->fold_chains[b];
+		ix->fold_chains[b] = id + 1;
+	}
+}
+
+static void _name_rehash(struct name_index *ix) {
+	size_t i;
+
+	mem_free(ix->chains);
+	mem_free(ix->fold_chains);
+	ix->buckets = ix->buckets ? ix->buckets * 2 : 64;
+	ix->chains = mem_zalloc(ix->buckets * sizeof(int));
+	ix->fold_chains = mem_zalloc(ix->buckets * sizeof(int));
+
+	for (i = 0; i < ix->filled; i++) {
+		ix->entries[i].next = ix->entries[i].fold_next = 0;
+		_name_link(ix, i);
+	}
+}
+
+struct name_index *name_index_new(void) {
+	struct name_index *ix = mem_zalloc(sizeof *ix);
+	_name_rehash(ix);
+	return ix;
+}
+
+void name_index_free(struct name_index *ix) {
+	size_t i;
+
+	if (!ix)
+		return;
+
+	for (i = 0; i < ix->filled; i++)
+		string_free(ix->entries[i].name);
+	for (i = 0; i < NAME_TRIGRAMS; i++)
+		mem_free(ix->trigrams[i].ids);
+	mem_free(ix->entries);
+	mem_free(ix->chains);
+	mem_free(ix->fold_chains);
+	mem_free(ix);
+}
+
+/**
+ * Add `name` to the index, to be found as `value`.
+ */
+void name_index_add(struct name_index *ix, const char *name, void *value) {
+	struct name_entry *e;
+	int id = ix->filled;
+	size_t i, len = strlen(name);
+
+	if (ix->filled == ix->allocated) {
+		ix->allocated = ix->allocated ? ix->allocated * 2 : 64;
+		ix->entries = mem_realloc(ix->entries,
+								  ix->allocated * sizeof(*ix->entries));
+	}
+
+	e = &ix->entries[ix->filled++];
+	e->name = string_make(name);
+	e->value = value;
+	e->hash = _name_hash(name, FALSE);
+	e->fold_hash = _name_hash(name, TRUE);
+	e->next = e->fold_next = 0;
+
+	if (ix->filled > ix->buckets)
+		_name_rehash(ix);
+	else
+		_name_link(ix, id);
+
+	/* Post the entry under each of its trigrams, once each */
+	for (i = 0; i + 3 <= len; i++) {
+		struct name_posting *post = &ix->trigrams[_name_trigram(name + i)];
+
+		if (post->filled && post->ids[post->filled - 1] == id)
+			continue;
+		if (post->filled == post->allocated) {
+			post->allocated = post->allocated ? post->allocated * 2 : 8;
+			post->ids = mem_realloc(post->ids,
+									post->allocated * sizeof(int));
+		}
+		post->ids[post->filled++] = id;
+	}
+}
+
+/**
+ * Find the value for `name` exactly, or NULL.
+ */
+void *name_index_find(const struct name_index *ix, const char *name) {
+	u32b h = _name_hash(name, FALSE);
+	int id;
+
+	for (id = ix->chains[h % ix->buckets]; id; id = ix->entries[id - 1].next) {
+		const struct name_entry *e = &ix->entries[id - 1];
+		if (e->hash == h && streq(e->name, name))
+			return e->value;
+	}
+
+	return NULL;
+}
+
+/**
+ * Find the value for `name` ignoring case, or NULL.
+ */
+void *name_index_find_nocase(const struct name_index *ix, const char *name) {
+	u32b h = _name_hash(name, TRUE);
+	int id;
+
+	for (id = ix->fold_chains[h % ix->buckets]; id;
+		 id = ix->entries[id - 1].fold_next) {
+		const struct name_entry *e = &ix->entries[id - 1];
+		if (e->fold_hash == h && !my_stricmp(e->name, name))
+			return e->value;
+	}
+
+	return NULL;
+}
+
+/**
+ * Find the value for the first name containing `part`, ignoring case (as
+ * my_stristr()), or NULL.
+ */
+void *name_index_search(const struct name_index *ix, const char *part) {
+	const struct name_posting *best = NULL;
+	size_t i, len = strlen(part);
+
+	/* Too short to have a trigram, so check every name */
+	if (len < 3) {
+		for (i = 0; i < ix->filled; i++)
+			if (my_stristr(ix->entries[i].name, part))
+				return ix->entries[i].value;
+		return NULL;
+	}
+
+	/* Any match has every trigram of the part; use the rarest */
+	for (i = 0; i + 3 <= len; i++) {
+		const struct name_posting *post = &ix->trigrams[_name_trigram(part + i)];
+		if (!best || post->filled < best->filled)
+			best = post;
+	}
+
+	for (i = 0; i < best->filled; i++) {
+		const struct name_entry *e = &ix->entries[best->ids[i]];
+		if (my_stristr(e->name, part))
+			return e->value;
+	}
+
+	return NULL;
+}
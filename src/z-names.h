@@ -0,0 +1,33 @@
+/**
+ * \file z-names.h
+ * \brief Indexes of named things, for lookup by name
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#ifndef Z_NAMES_H
+#define Z_NAMES_H
+
+#include "h-basic.h"
+
+struct name_index;
+
+extern struct name_index *name_index_new(void);
+extern void name_index_free(struct name_index *ix);
+extern void name_index_add(struct name_index *ix, const char *name,
+						   void *value);
+extern void *name_index_find(const struct name_index *ix, const char *name);
+extern void *name_index_find_nocase(const struct name_index *ix,
+									const char *name);
+extern void *name_index_search(const struct name_index *ix, const char *part);
+
+#endif /* !Z_NAMES_H */